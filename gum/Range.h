@@ -59,6 +59,14 @@ class Range {
             m_iterable -= m_step;
         }
 
+        Iterable_ get_value() const {
+            return m_iterable;
+        }
+
+        Iterable_ get_step() const {
+            return m_step;
+        }
+
       private:
         Iterable_ m_iterable;
         Iterable_ m_step;
@@ -93,6 +101,14 @@ class Range {
         return m_end;
     }
 
+    size_t size() const {
+        return static_cast<size_t>((m_end.get_value() - m_begin.get_value()) / m_begin.get_step());
+    }
+
+    Iterable_ operator[](size_t index) const {
+        return m_begin.get_value() + static_cast<Iterable_>(index) * m_begin.get_step();
+    }
+
   private:
     Counter m_begin;
     Counter m_end;
@@ -0,0 +1,170 @@
+/*
+ * Copyright (c) Vladimir Golubev
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <gum/Try.h>
+#include <gum/async/ITaskQueue.h>
+#include <gum/concurrency/LifeToken.h>
+#include <gum/concurrency/MpscQueue.h>
+#include <gum/log/LoggerSingleton.h>
+#include <gum/smartpointer/UniquePtr.h>
+
+#include <thread>
+
+namespace gum {
+
+namespace detail {
+
+GUM_LOGGER_SINGLETON(ActorLogger);
+}
+
+template <typename Message_>
+class Actor {
+    class Impl;
+    GUM_DECLARE_PTR(Impl);
+    GUM_DECLARE_REF(Impl);
+
+  public:
+    using Handler = std::function<void(Message_&)>;
+
+    static constexpr size_t DefaultBatchSize = 64;
+
+    class Address {
+        ImplPtr _impl;
+
+      public:
+        Address() = default;
+
+        Address(ImplRef const& impl)
+            : _impl(impl) {}
+
+        void send(Message_ message) const {
+            if (_impl)
+                _impl->try_push(_impl, std::move(message));
+        }
+
+        explicit operator bool() const {
+            return (bool)_impl;
+        }
+    };
+
+  private:
+    LifeToken _life_token;
+    ImplRef _impl;
+
+  public:
+    template <typename Handler_>
+    Actor(ITaskQueueRef const& executor, Handler_&& handler, size_t batch_size = DefaultBatchSize)
+        : _life_token(LifeToken::make_synchronized())
+        , _impl(make_shared_ref<Impl>(executor, std::forward<Handler_>(handler), _life_token.get_handle(), batch_size)) {}
+
+    Actor(Actor const&) = delete;
+    Actor& operator=(Actor const&) = delete;
+
+    void send(Message_ message) {
+        _impl->push(_impl, std::move(message));
+    }
+
+    Address get_address() const {
+        return Address(_impl);
+    }
+};
+
+template <typename Message_>
+class Actor<Message_>::Impl {
+    struct MessageNode : public MpscQueueHook {
+        Message_ message;
+
+      public:
+        MessageNode(Message_&& message_)
+            : message(std::move(message_)) {}
+    };
+    GUM_DECLARE_UNIQUE_PTR(MessageNode);
+
+  private:
+    ITaskQueueRef _executor;
+    Handler _handler;
+    LifeHandle _life_handle;
+    size_t _batch_size;
+
+    IntrusiveMpscQueue<MessageNode, alignof(MpscQueueHook)> _mailbox;
+    std::atomic<size_t> _pending;
+
+  public:
+    Impl(ITaskQueueRef const& executor, Handler const& handler, LifeHandle const& life_handle, size_t batch_size)
+        : _executor(executor)
+        , _handler(handler)
+        , _life_handle(life_handle)
+        , _batch_size(batch_size)
+        , _pending(0) {
+        GUM_CHECK(_batch_size, ArgumentException("batch_size", _batch_size));
+    }
+
+    ~Impl() {
+        while (MessageNodeUniquePtr(_mailbox.pop()))
+            ;
+    }
+
+    void push(ImplRef const& self, Message_&& message) {
+        _mailbox.push(new MessageNode(std::move(message)));
+
+        if (_pending.fetch_add(1, std::memory_order_acq_rel) == 0)
+            schedule(self);
+    }
+
+    void try_push(ImplRef const& self, Message_&& message) {
+        LifeHandleLock l(_life_handle);
+        if (l)
+            push(self, std::move(message));
+    }
+
+  private:
+    void schedule(ImplRef const& self) {
+        _executor->push([self] { self->drain(self); });
+    }
+
+    void drain(ImplRef const& self) {
+        {
+            LifeHandleLock l(_life_handle);
+
+            for (size_t i = 0; i < _batch_size; ++i) {
+                const MessageNodeUniquePtr node = pop();
+                if (l)
+                    GUM_TRY_LOGGER("Uncaught exception in actor handler", LogLevel::Error, detail::ActorLogger::get(), _handler(node->message));
+
+                if (_pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                    return;
+            }
+        }
+
+        schedule(self);
+    }
+
+    MessageNodeUniquePtr pop() {
+        MessageNode* node;
+        while (!(node = _mailbox.pop()))
+            std::this_thread::yield();
+        return node;
+    }
+};
+}
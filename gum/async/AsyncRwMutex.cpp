@@ -0,0 +1,265 @@
+/*
+ * Copyright (c) Vladimir Golubev
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <gum/async/AsyncRwMutex.h>
+
+#include <gum/concurrency/Mutex.h>
+
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <vector>
+
+namespace gum {
+
+namespace detail {
+
+class AsyncMutexState {
+    using Continuation = AsyncRwMutex::Continuation;
+
+    struct Waiter {
+        ITaskQueue& Queue;
+        Continuation Callback;
+        bool Exclusive;
+        std::atomic<bool> Claimed;
+        Token CancellationRegistration;
+
+      public:
+        Waiter(ITaskQueue& queue, Continuation const& callback, bool exclusive)
+            : Queue(queue)
+            , Callback(callback)
+            , Exclusive(exclusive)
+            , Claimed(false) {}
+
+        bool claim() {
+            return !Claimed.exchange(true, std::memory_order_acq_rel);
+        }
+    };
+    GUM_DECLARE_PTR(Waiter);
+    GUM_DECLARE_REF(Waiter);
+
+    using Grants = std::vector<WaiterRef>;
+
+  private:
+    mutable Mutex _mutex;
+    std::deque<WaiterRef> _waiters;
+    size_t _readers;
+    bool _writer;
+
+  public:
+    AsyncMutexState()
+        : _readers(0)
+        , _writer(false) {}
+
+    void lock(AsyncMutexStateRef const& self, ITaskQueue& queue, Continuation const& continuation, bool exclusive, ICancellationHandle& handle) {
+        const WaiterRef waiter = make_shared_ref<Waiter>(queue, continuation, exclusive);
+
+        if (!handle) {
+            waiter->claim();
+            complete(self, waiter, false);
+            return;
+        }
+
+        if (try_acquire(exclusive)) {
+            waiter->claim();
+            complete(self, waiter, true);
+            return;
+        }
+
+        const WaiterWeakPtr waiter_weak = waiter;
+        waiter->CancellationRegistration = handle.on_cancelled([self, waiter_weak] {
+            if (WaiterPtr waiter = waiter_weak.lock())
+                self->cancel(self, std::move(waiter));
+        });
+
+        bool granted = false;
+        {
+            MutexLock l(_mutex);
+            if (waiter->Claimed.load(std::memory_order_acquire))
+                return;
+
+            if (_waiters.empty() && can_acquire(exclusive) && waiter->claim()) {
+                acquire(exclusive);
+                granted = true;
+            } else
+                _waiters.push_back(waiter);
+        }
+
+        if (granted)
+            complete(self, waiter, true);
+        else if (!handle)
+            cancel(self, waiter);
+    }
+
+    AsyncMutexLock try_lock(AsyncMutexStateRef const& self, bool exclusive) {
+        if (!try_acquire(exclusive))
+            return AsyncMutexLock();
+        return AsyncMutexLock(self, exclusive);
+    }
+
+    void release(AsyncMutexStateRef const& self, bool exclusive) {
+        Grants grants;
+        {
+            MutexLock l(_mutex);
+            if (exclusive)
+                _writer = false;
+            else
+                --_readers;
+
+            collect_grants(grants);
+        }
+
+        complete(self, std::move(grants));
+    }
+
+    size_t get_waiters_count() const {
+        MutexLock l(_mutex);
+        return _waiters.size();
+    }
+
+  private:
+    bool can_acquire(bool exclusive) const {
+        return exclusive ? !_writer && _readers == 0 : !_writer;
+    }
+
+    void acquire(bool exclusive) {
+        if (exclusive)
+            _writer = true;
+        else
+            ++_readers;
+    }
+
+    bool try_acquire(bool exclusive) {
+        MutexLock l(_mutex);
+        if (!_waiters.empty() || !can_acquire(exclusive))
+            return false;
+
+        acquire(exclusive);
+        return true;
+    }
+
+    void collect_grants(Grants& grants) {
+        while (!_waiters.empty() && can_acquire(_waiters.front()->Exclusive)) {
+            WaiterRef const waiter = _waiters.front();
+            _waiters.pop_front();
+
+            if (!waiter->claim())
+                continue;
+
+            acquire(waiter->Exclusive);
+            grants.push_back(waiter);
+        }
+    }
+
+    void cancel(AsyncMutexStateRef const& self, WaiterRef waiter) {
+        if (!waiter->claim())
+            return;
+
+        Grants grants;
+        {
+            MutexLock l(_mutex);
+            const auto it = std::find_if(_waiters.begin(), _waiters.end(), [&](WaiterRef const& w) { return &*w == &*waiter; });
+            if (it != _waiters.end())
+                _waiters.erase(it);
+
+            collect_grants(grants);
+        }
+
+        complete(self, std::move(grants));
+        complete(self, std::move(waiter), false);
+    }
+
+    static void complete(AsyncMutexStateRef const& self, Grants&& grants) {
+        for (WaiterRef& waiter : grants)
+            complete(self, std::move(waiter), true);
+    }
+
+    static void complete(AsyncMutexStateRef const& self, WaiterRef waiter, bool granted) {
+        const auto lock = make_shared_ref<AsyncMutexLock>();
+        if (granted)
+            *lock = AsyncMutexLock(self, waiter->Exclusive);
+
+        ITaskQueue& queue = waiter->Queue;
+        queue.push([waiter = std::move(waiter), lock] { waiter->Callback(std::move(*lock)); });
+    }
+};
+}
+
+AsyncMutexLock::AsyncMutexLock(detail::AsyncMutexStateRef const& state, bool exclusive)
+    : _state(state)
+    , _exclusive(exclusive) {}
+
+AsyncMutexLock::AsyncMutexLock()
+    : _exclusive(false) {}
+
+AsyncMutexLock::AsyncMutexLock(AsyncMutexLock&& other)
+    : _state(std::move(other._state))
+    , _exclusive(other._exclusive) {
+    other._state = nullptr;
+}
+
+AsyncMutexLock::~AsyncMutexLock() {
+    unlock();
+}
+
+AsyncMutexLock& AsyncMutexLock::operator=(AsyncMutexLock&& other) {
+    if (this != &other) {
+        unlock();
+        _state = std::move(other._state);
+        _exclusive = other._exclusive;
+        other._state = nullptr;
+    }
+    return *this;
+}
+
+void AsyncMutexLock::unlock() {
+    if (!_state)
+        return;
+
+    const detail::AsyncMutexStateRef state(_state);
+    _state = nullptr;
+    state->release(state, _exclusive);
+}
+
+AsyncRwMutex::AsyncRwMutex()
+    : _state(make_shared_ref<detail::AsyncMutexState>()) {}
+
+void AsyncRwMutex::lock(ITaskQueue& queue, Continuation const& continuation, ICancellationHandle& handle) {
+    _state->lock(_state, queue, continuation, true, handle);
+}
+
+void AsyncRwMutex::lock_shared(ITaskQueue& queue, Continuation const& continuation, ICancellationHandle& handle) {
+    _state->lock(_state, queue, continuation, false, handle);
+}
+
+AsyncMutexLock AsyncRwMutex::try_lock() {
+    return _state->try_lock(_state, true);
+}
+
+AsyncMutexLock AsyncRwMutex::try_lock_shared() {
+    return _state->try_lock(_state, false);
+}
+
+size_t AsyncRwMutex::get_waiters_count() const {
+    return _state->get_waiters_count();
+}
+}
@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) Vladimir Golubev
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <gum/async/ITaskQueue.h>
+#include <gum/concurrency/DummyCancellationHandle.h>
+#include <gum/concurrency/ICancellationToken.h>
+
+namespace gum {
+
+namespace detail {
+
+class AsyncMutexState;
+GUM_DECLARE_PTR(AsyncMutexState);
+GUM_DECLARE_REF(AsyncMutexState);
+}
+
+class AsyncMutexLock {
+    friend class detail::AsyncMutexState;
+
+  private:
+    detail::AsyncMutexStatePtr _state;
+    bool _exclusive;
+
+  private:
+    AsyncMutexLock(detail::AsyncMutexStateRef const& state, bool exclusive);
+
+  public:
+    AsyncMutexLock();
+    AsyncMutexLock(AsyncMutexLock&& other);
+    ~AsyncMutexLock();
+
+    AsyncMutexLock(AsyncMutexLock const&) = delete;
+    AsyncMutexLock& operator=(AsyncMutexLock const&) = delete;
+    AsyncMutexLock& operator=(AsyncMutexLock&& other);
+
+    explicit operator bool() const {
+        return (bool)_state;
+    }
+
+    bool is_exclusive() const {
+        return _state && _exclusive;
+    }
+
+    void unlock();
+};
+
+class AsyncRwMutex {
+  public:
+    using Continuation = std::function<void(AsyncMutexLock&&)>;
+
+  private:
+    detail::AsyncMutexStateRef _state;
+
+  public:
+    AsyncRwMutex();
+
+    AsyncRwMutex(AsyncRwMutex const&) = delete;
+    AsyncRwMutex& operator=(AsyncRwMutex const&) = delete;
+
+    void lock(ITaskQueue& queue, Continuation const& continuation, ICancellationHandle& handle = *DummyCancellationHandle());
+    void lock_shared(ITaskQueue& queue, Continuation const& continuation, ICancellationHandle& handle = *DummyCancellationHandle());
+
+    AsyncMutexLock try_lock();
+    AsyncMutexLock try_lock_shared();
+
+    size_t get_waiters_count() const;
+};
+}
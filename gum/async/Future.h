@@ -0,0 +1,552 @@
+/*
+ * Copyright (c) Vladimir Golubev
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <gum/ErrorOr.h>
+#include <gum/Optional.h>
+#include <gum/Unit.h>
+#include <gum/async/CurrentTaskQueue.h>
+#include <gum/async/ITaskQueue.h>
+#include <gum/concurrency/DummyCancellationHandle.h>
+#include <gum/concurrency/ManualResetEvent.h>
+#include <gum/token/FunctionToken.h>
+
+#include <atomic>
+#include <exception>
+#include <vector>
+
+namespace gum {
+
+GUM_DECLARE_EXCEPTION(BrokenPromiseException, "Promise was destroyed without a result");
+
+template <typename Value_>
+class Future;
+
+template <typename Value_>
+class Promise;
+
+namespace detail {
+
+struct IFutureState {
+    virtual ~IFutureState() {}
+
+    virtual void cancel() = 0;
+};
+GUM_DECLARE_PTR(IFutureState);
+GUM_DECLARE_REF(IFutureState);
+
+// Shares ownership of the exception object itself, so the error keeps its dynamic type
+inline ExceptionRef share_exception(std::exception_ptr const& exception) {
+    const auto holder = make_shared_ref<std::exception_ptr>(exception);
+    try {
+        std::rethrow_exception(*holder);
+    } catch (std::exception& ex) {
+        return ExceptionRef(holder, &ex);
+    }
+}
+
+inline ExceptionRef capture_exception() {
+    try {
+        throw;
+    } catch (ExceptionRef const& ex) {
+        return ex;
+    } catch (std::exception const&) {
+        return share_exception(std::current_exception());
+    } catch (...) {
+        return make_shared_ref<Exception>("<unknown exception>");
+    }
+}
+
+inline size_t& inline_continuation_depth() {
+    thread_local size_t depth = 0;
+    return depth;
+}
+
+template <typename Value_>
+class FutureState : public virtual IFutureState {
+  public:
+    using Result = ErrorOr<Value_>;
+    using Continuation = std::function<void()>;
+
+  private:
+    enum class Stage : u8 { Pending, Continued, Ready };
+
+  private:
+    std::atomic<Stage> _stage;
+    std::atomic<bool> _completed;
+    std::atomic<bool> _cancelled;
+
+    Optional<Result> _result;
+    Continuation _continuation;
+
+    IFutureStateWeakPtr _upstream;
+
+  public:
+    FutureState(IFutureStateWeakPtr const& upstream = IFutureStateWeakPtr())
+        : _stage(Stage::Pending)
+        , _completed(false)
+        , _cancelled(false)
+        , _upstream(upstream) {}
+
+    bool set_result(Result&& result) {
+        if (_completed.exchange(true, std::memory_order_acq_rel))
+            return false;
+
+        _result = std::move(result);
+        if (_stage.exchange(Stage::Ready, std::memory_order_acq_rel) == Stage::Continued)
+            fire();
+        return true;
+    }
+
+    void set_continuation(Continuation&& continuation) {
+        GUM_CHECK(_stage.load(std::memory_order_acquire) != Stage::Continued, LogicError("Future continuation already set"));
+        _continuation = std::move(continuation);
+
+        Stage expected = Stage::Pending;
+        if (!_stage.compare_exchange_strong(expected, Stage::Continued, std::memory_order_acq_rel))
+            fire();
+    }
+
+    Result take_result() {
+        return std::move(*_result);
+    }
+
+    bool is_ready() const {
+        return _stage.load(std::memory_order_acquire) == Stage::Ready;
+    }
+
+    bool is_cancelled() const {
+        return _cancelled.load(std::memory_order_acquire);
+    }
+
+    void set_upstream(IFutureStateWeakPtr const& upstream) {
+        _upstream = upstream;
+    }
+
+    void cancel() override {
+        if (_cancelled.exchange(true, std::memory_order_acq_rel))
+            return;
+
+        if (IFutureStatePtr const upstream = _upstream.lock())
+            upstream->cancel();
+
+        set_result(ExceptionRef(make_shared_ref<OperationCancelledException>()));
+    }
+
+  private:
+    void fire() {
+        Continuation continuation = std::move(_continuation);
+        continuation();
+    }
+};
+
+template <typename Value_>
+using FutureStateRef = SharedReference<FutureState<Value_>>;
+
+template <typename Value_, typename Callable_>
+void fulfill(FutureState<Value_>& state, Callable_&& callable) {
+    try {
+        state.set_result(callable());
+    } catch (...) {
+        state.set_result(capture_exception());
+    }
+}
+
+template <typename Result_>
+struct ContinuationTraits {
+    using Value = Result_;
+
+    template <typename Callable_>
+    static void apply(FutureStateRef<Value> const& state, Callable_&& callable) {
+        fulfill(*state, std::forward<Callable_>(callable));
+    }
+};
+
+template <>
+struct ContinuationTraits<void> {
+    using Value = Unit;
+
+    template <typename Callable_>
+    static void apply(FutureStateRef<Value> const& state, Callable_&& callable) {
+        fulfill(*state, [&] {
+            callable();
+            return Unit();
+        });
+    }
+};
+
+template <typename Value_>
+struct ContinuationTraits<Future<Value_>> {
+    using Value = Value_;
+
+    template <typename Callable_>
+    static void apply(FutureStateRef<Value> const& state, Callable_&& callable) {
+        try {
+            callable().forward_to(state);
+        } catch (...) {
+            state->set_result(capture_exception());
+        }
+    }
+};
+
+template <typename Task_>
+void run_on(ITaskQueueRef const& queue, Task_&& task) {
+    constexpr size_t MaxInlineDepth = 16;
+
+    size_t& depth = inline_continuation_depth();
+    if (!CurrentTaskQueue::is(*queue) || depth >= MaxInlineDepth) {
+        queue->push(std::forward<Task_>(task));
+        return;
+    }
+
+    ++depth;
+    try {
+        task();
+    } catch (...) {
+        --depth;
+        throw;
+    }
+    --depth;
+}
+}
+
+template <typename Value_>
+class Future {
+    using State = detail::FutureState<Value_>;
+    using StateRef = detail::FutureStateRef<Value_>;
+    GUM_DECLARE_PTR(State);
+
+    template <typename>
+    friend class Future;
+
+    template <typename>
+    friend class Promise;
+
+    template <typename>
+    friend struct detail::ContinuationTraits;
+
+    template <typename Value__>
+    friend Future<std::vector<Value__>> when_all(std::vector<Future<Value__>>&& futures);
+
+    template <typename Value__>
+    friend Future<std::pair<size_t, Value__>> when_any(std::vector<Future<Value__>>&& futures);
+
+  public:
+    using value_type = Value_;
+    using Result = ErrorOr<Value_>;
+
+  private:
+    StatePtr _state;
+
+  private:
+    Future(StateRef const& state)
+        : _state(state) {}
+
+  public:
+    Future() = default;
+
+    Future(Future const&) = delete;
+    Future& operator=(Future const&) = delete;
+    Future(Future&&) = default;
+    Future& operator=(Future&&) = default;
+
+    explicit operator bool() const {
+        return (bool)_state;
+    }
+
+    bool is_ready() const {
+        return get_state()->is_ready();
+    }
+
+    template <typename Callable_>
+    auto then(ITaskQueueRef const& queue, Callable_&& callable) {
+        return then_result(queue, [callable = std::forward<Callable_>(callable)](Result&& result) mutable {
+            if (Value_* const value = boost::get<Value_>(&result))
+                return callable(std::move(*value));
+            throw_error(result);
+        });
+    }
+
+    template <typename Callable_>
+    auto then_result(ITaskQueueRef const& queue, Callable_&& callable) {
+        using CallableResult = std::decay_t<std::result_of_t<Callable_(Result &&)>>;
+        using Traits = detail::ContinuationTraits<CallableResult>;
+        using NextValue = typename Traits::Value;
+
+        StateRef const state = take_state();
+        auto const next = make_shared_ref<detail::FutureState<NextValue>>(detail::IFutureStateWeakPtr(state));
+
+        state->set_continuation([queue, state, next, callable = std::forward<Callable_>(callable)]() mutable {
+            detail::run_on(queue, [state, next, callable = std::move(callable)]() mutable {
+                Result result = state->take_result();
+                if (next->is_cancelled())
+                    return;
+
+                Traits::apply(next, [&] { return callable(std::move(result)); });
+            });
+        });
+
+        return Future<NextValue>(next);
+    }
+
+    Result get(ICancellationHandle& handle) {
+        StateRef const state = take_state();
+        auto const ready = make_shared_ref<ManualResetEvent>();
+
+        state->set_continuation([ready] { ready->set(); });
+
+        if (!ready->wait(handle)) {
+            state->cancel();
+            ready->wait(*DummyCancellationHandle());
+        }
+
+        return state->take_result();
+    }
+
+    void cancel() {
+        get_state()->cancel();
+    }
+
+    Token cancel_on(ICancellationHandle& handle) {
+        detail::IFutureStateWeakPtr const state_weak = get_state();
+
+        Token token = handle.on_cancelled([state_weak] {
+            if (detail::IFutureStatePtr const state = state_weak.lock())
+                state->cancel();
+        });
+        if (!handle)
+            cancel();
+
+        return token;
+    }
+
+  private:
+    StateRef get_state() const {
+        GUM_CHECK(_state, LogicError("Future is empty or has already been consumed"));
+        return _state;
+    }
+
+    StateRef take_state() {
+        StateRef state = get_state();
+        _state = nullptr;
+        return state;
+    }
+
+    void forward_to(StateRef const& target) {
+        StateRef const state = take_state();
+        state->set_continuation([state, target] { target->set_result(state->take_result()); });
+    }
+
+    [[noreturn]] static void throw_error(Result const& result) {
+        throw boost::get<ExceptionRef>(result);
+    }
+};
+
+template <typename Value_>
+class Promise {
+    using State = detail::FutureState<Value_>;
+    using StateRef = detail::FutureStateRef<Value_>;
+    GUM_DECLARE_PTR(State);
+
+  public:
+    using Result = ErrorOr<Value_>;
+
+  private:
+    StatePtr _state;
+    bool _future_retrieved;
+
+  public:
+    Promise()
+        : _state(make_shared_ref<State>())
+        , _future_retrieved(false) {}
+
+    Promise(Promise const&) = delete;
+    Promise& operator=(Promise const&) = delete;
+
+    Promise(Promise&& other)
+        : _state(std::move(other._state))
+        , _future_retrieved(other._future_retrieved) {
+        other._state = nullptr;
+    }
+
+    Promise& operator=(Promise&& other) {
+        break_promise();
+        _state = std::move(other._state);
+        _future_retrieved = other._future_retrieved;
+        other._state = nullptr;
+        return *this;
+    }
+
+    ~Promise() {
+        break_promise();
+    }
+
+    Future<Value_> get_future() {
+        GUM_CHECK(!_future_retrieved, LogicError("Future already retrieved"));
+        _future_retrieved = true;
+        return Future<Value_>(get_state());
+    }
+
+    bool set_value(Value_ value) {
+        return set_result(Result(std::move(value)));
+    }
+
+    bool set_error(ExceptionRef const& error) {
+        return set_result(Result(error));
+    }
+
+    bool set_result(Result&& result) {
+        return get_state()->set_result(std::move(result));
+    }
+
+    bool is_cancelled() const {
+        return get_state()->is_cancelled();
+    }
+
+  private:
+    StateRef get_state() const {
+        GUM_CHECK(_state, LogicError("Promise has been moved from"));
+        return _state;
+    }
+
+    void break_promise() {
+        if (_state)
+            _state->set_result(ExceptionRef(make_shared_ref<BrokenPromiseException>()));
+    }
+};
+
+template <typename Value_>
+Future<Value_> make_ready_future(Value_ value) {
+    Promise<Value_> promise;
+    promise.set_value(std::move(value));
+    return promise.get_future();
+}
+
+template <typename Value_>
+Future<Value_> make_failed_future(ExceptionRef const& error) {
+    Promise<Value_> promise;
+    promise.set_error(error);
+    return promise.get_future();
+}
+
+namespace detail {
+
+template <typename Result_>
+class FutureAggregate : public virtual IFutureState {
+    using States = std::vector<IFutureStateWeakPtr>;
+
+  private:
+    States _inputs;
+
+  public:
+    Promise<Result_> promise;
+
+  public:
+    void add_input(IFutureStateWeakPtr const& input) {
+        _inputs.push_back(input);
+    }
+
+    void cancel() override {
+        for (auto const& input : _inputs)
+            if (IFutureStatePtr const state = input.lock())
+                state->cancel();
+    }
+};
+}
+
+template <typename Value_>
+Future<std::vector<Value_>> when_all(std::vector<Future<Value_>>&& futures) {
+    using Results = std::vector<Value_>;
+
+    struct Aggregate : public detail::FutureAggregate<Results> {
+        std::vector<Optional<Value_>> values;
+        std::atomic<size_t> remaining;
+
+      public:
+        Aggregate(size_t count)
+            : values(count)
+            , remaining(count) {}
+    };
+
+    auto const aggregate = make_shared_ref<Aggregate>(futures.size());
+    Future<Results> result = aggregate->promise.get_future();
+    result.get_state()->set_upstream(detail::IFutureStateWeakPtr(aggregate));
+
+    if (futures.empty()) {
+        aggregate->promise.set_value(Results());
+        return result;
+    }
+
+    for (size_t i = 0; i < futures.size(); ++i) {
+        auto const state = futures[i].take_state();
+        aggregate->add_input(state);
+
+        state->set_continuation([aggregate, state, i] {
+            auto input = state->take_result();
+            if (Value_* const value = boost::get<Value_>(&input))
+                aggregate->values[i] = std::move(*value);
+            else
+                aggregate->promise.set_error(boost::get<ExceptionRef>(input));
+
+            if (aggregate->remaining.fetch_sub(1, std::memory_order_acq_rel) != 1)
+                return;
+
+            Results results;
+            results.reserve(aggregate->values.size());
+            for (auto& value : aggregate->values)
+                if (value)
+                    results.push_back(std::move(*value));
+            if (results.size() == aggregate->values.size())
+                aggregate->promise.set_value(std::move(results));
+        });
+    }
+
+    return result;
+}
+
+template <typename Value_>
+Future<std::pair<size_t, Value_>> when_any(std::vector<Future<Value_>>&& futures) {
+    using Result = std::pair<size_t, Value_>;
+
+    GUM_CHECK(!futures.empty(), ArgumentException("futures.size()", futures.size()));
+
+    auto const aggregate = make_shared_ref<detail::FutureAggregate<Result>>();
+    Future<Result> result = aggregate->promise.get_future();
+    result.get_state()->set_upstream(detail::IFutureStateWeakPtr(aggregate));
+
+    for (size_t i = 0; i < futures.size(); ++i) {
+        auto const state = futures[i].take_state();
+        aggregate->add_input(state);
+
+        state->set_continuation([aggregate, state, i] {
+            auto input = state->take_result();
+            if (Value_* const value = boost::get<Value_>(&input))
+                aggregate->promise.set_value(Result(i, std::move(*value)));
+            else
+                aggregate->promise.set_error(boost::get<ExceptionRef>(input));
+        });
+    }
+
+    return result;
+}
+}
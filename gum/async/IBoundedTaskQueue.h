@@ -0,0 +1,47 @@
+/*
+ * Copyright (c) Vladimir Golubev
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <gum/async/ITaskQueue.h>
+#include <gum/async/TaskQueueLimits.h>
+#include <gum/concurrency/ICancellationToken.h>
+
+namespace gum {
+
+GUM_DECLARE_EXCEPTION(TaskQueueOverflowException, "Task queue overflow");
+
+struct IBoundedTaskQueue : public virtual ITaskQueue {
+    using ITaskQueue::push;
+
+    virtual PushResult try_push(Task&& task) = 0;
+    virtual PushResult try_push(CoalescingKey key, Task&& task) = 0;
+
+    virtual PushResult push(Task&& task, ICancellationHandle& handle) = 0;
+    virtual PushResult push(CoalescingKey key, Task&& task, ICancellationHandle& handle) = 0;
+
+    virtual TaskQueueLimits get_limits() const = 0;
+    virtual size_t size() const = 0;
+};
+GUM_DECLARE_PTR(IBoundedTaskQueue);
+GUM_DECLARE_REF(IBoundedTaskQueue);
+}
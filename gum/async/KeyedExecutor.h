@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) Vladimir Golubev
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <gum/async/Strand.h>
+
+#include <functional>
+#include <vector>
+
+namespace gum {
+
+template <typename Key_, typename Hash_ = std::hash<Key_>>
+class KeyedExecutor {
+    using Task = ITaskQueue::Task;
+    using Strands = std::vector<StrandRef>;
+
+  private:
+    Strands _strands;
+    Hash_ _hash;
+
+  public:
+    KeyedExecutor(ITaskQueueRef const& executor, size_t shard_count, size_t batch_size = Strand::DefaultBatchSize, Hash_ const& hash = Hash_())
+        : _hash(hash) {
+        GUM_CHECK(shard_count, ArgumentException("shard_count", shard_count));
+
+        _strands.reserve(shard_count);
+        for (size_t i = 0; i < shard_count; ++i)
+            _strands.push_back(make_shared_ref<Strand>(executor, batch_size));
+    }
+
+    void push(Key_ const& key, Task&& task) {
+        get_queue(key)->push(std::move(task));
+    }
+
+    StrandRef get_queue(Key_ const& key) const {
+        return _strands[_hash(key) % _strands.size()];
+    }
+
+    size_t get_shard_count() const {
+        return _strands.size();
+    }
+};
+}
@@ -74,7 +74,8 @@ class LifeHandleLock {
         , _alive(_handle.lock()) {}
 
     ~LifeHandleLock() {
-        _handle.unlock();
+        if (_alive)
+            _handle.unlock();
     }
 
     explicit operator bool() const {
@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) Vladimir Golubev
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <gum/async/Parallel.h>
+
+#include <gum/concurrency/DummyCancellationHandle.h>
+#include <gum/concurrency/Latch.h>
+
+#include <atomic>
+#include <exception>
+
+namespace gum {
+namespace detail {
+
+namespace {
+
+class ParallelRun {
+    size_t _size;
+    size_t _grain;
+    size_t _chunk_count;
+
+    ParallelBody const& _body;
+
+    std::atomic<size_t> _next_chunk{0};
+    std::atomic<bool> _failed{false};
+    std::exception_ptr _error;
+
+    Latch _done;
+
+  public:
+    ParallelRun(size_t size, size_t grain, ParallelBody const& body)
+        : _size(size)
+        , _grain(grain)
+        , _chunk_count((size + grain - 1) / grain)
+        , _body(body)
+        , _done(_chunk_count) {}
+
+    size_t get_chunk_count() const {
+        return _chunk_count;
+    }
+
+    void run_chunks() {
+        for (size_t chunk; (chunk = _next_chunk.fetch_add(1, std::memory_order_relaxed)) < _chunk_count; _done.count_down()) {
+            if (_failed.load(std::memory_order_relaxed))
+                continue;
+
+            try {
+                _body(chunk * _grain, std::min(_size, (chunk + 1) * _grain));
+            } catch (...) {
+                if (!_failed.exchange(true))
+                    _error = std::current_exception();
+            }
+        }
+    }
+
+    void wait() {
+        _done.wait(*DummyCancellationHandle());
+        if (_error)
+            std::rethrow_exception(_error);
+    }
+};
+GUM_DECLARE_REF(ParallelRun);
+}
+
+size_t get_parallel_grain(size_t size, ParallelOptions const& options) {
+    constexpr size_t MaxChunkCount = 1 << 20;
+    constexpr size_t ChunksPerParticipant = 8;
+
+    const size_t grain = options.Grain ? options.Grain : size / (std::max<size_t>(1, options.Concurrency) * ChunksPerParticipant);
+    return std::max({grain, (size + MaxChunkCount - 1) / MaxChunkCount, size_t(1)});
+}
+
+void parallel_run(ITaskQueue& executor, size_t size, ParallelOptions const& options, ParallelBody const& body) {
+    if (!size)
+        return;
+
+    if (size <= options.SerialCutoff || options.Concurrency <= 1) {
+        body(0, size);
+        return;
+    }
+
+    const auto run = make_shared_ref<ParallelRun>(size, get_parallel_grain(size, options), body);
+    for (size_t i = 1; i < std::min(options.Concurrency, run->get_chunk_count()); ++i)
+        executor.push([run] { run->run_chunks(); });
+
+    run->run_chunks();
+    run->wait();
+}
+}
+}
@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) Vladimir Golubev
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <gum/Range.h>
+#include <gum/Slice.h>
+#include <gum/async/ITaskQueue.h>
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <thread>
+#include <vector>
+
+namespace gum {
+
+struct ParallelOptions {
+    size_t Concurrency = std::max(1u, std::thread::hardware_concurrency());
+    size_t Grain = 0;
+    size_t SerialCutoff = 1024;
+};
+
+namespace detail {
+
+using ParallelBody = std::function<void(size_t begin, size_t end)>;
+
+size_t get_parallel_grain(size_t size, ParallelOptions const& options);
+void parallel_run(ITaskQueue& executor, size_t size, ParallelOptions const& options, ParallelBody const& body);
+
+template <typename Iterable_>
+size_t get_parallel_size(Range<Iterable_> const& range) {
+    return range.size();
+}
+
+template <typename Iterable_>
+Iterable_ get_parallel_element(Range<Iterable_> const& range, size_t index) {
+    return range[index];
+}
+
+template <typename Value_>
+size_t get_parallel_size(Slice<Value_> const& slice) {
+    return slice.size();
+}
+
+template <typename Value_>
+Value_ const& get_parallel_element(Slice<Value_> const& slice, size_t index) {
+    return slice.data()[index];
+}
+}
+
+template <typename Source_, typename Callable_>
+void parallel_for(ITaskQueue& executor, Source_ const& source, Callable_ const& callable, ParallelOptions const& options = ParallelOptions()) {
+    detail::parallel_run(executor, detail::get_parallel_size(source), options, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+            callable(detail::get_parallel_element(source, i));
+    });
+}
+
+template <typename Source_, typename OutputIt_, typename Callable_>
+void parallel_transform(ITaskQueue& executor, Source_ const& source, OutputIt_ output, Callable_ const& callable, ParallelOptions const& options = ParallelOptions()) {
+    static_assert(std::is_base_of<std::random_access_iterator_tag, typename std::iterator_traits<OutputIt_>::iterator_category>::value,
+        "parallel_transform requires a random access output iterator");
+
+    detail::parallel_run(executor, detail::get_parallel_size(source), options, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+            output[i] = callable(detail::get_parallel_element(source, i));
+    });
+}
+
+template <typename Source_, typename Value_, typename Combine_, typename Map_>
+Value_ parallel_reduce(ITaskQueue& executor, Source_ const& source, Value_ const& identity, Combine_ const& combine, Map_ const& map,
+    ParallelOptions const& options = ParallelOptions()) {
+    const size_t size = detail::get_parallel_size(source);
+
+    ParallelOptions chunk_options = options;
+    chunk_options.Grain = detail::get_parallel_grain(size, options);
+
+    std::vector<Value_> partials((size + chunk_options.Grain - 1) / chunk_options.Grain, identity);
+    detail::parallel_run(executor, size, chunk_options, [&](size_t begin, size_t end) {
+        Value_& partial = partials[begin / chunk_options.Grain];
+        for (size_t i = begin; i < end; ++i)
+            partial = combine(std::move(partial), map(detail::get_parallel_element(source, i)));
+    });
+
+    Value_ result = identity;
+    for (auto& partial : partials)
+        result = combine(std::move(result), std::move(partial));
+    return result;
+}
+
+template <typename Source_, typename Value_, typename Combine_>
+Value_ parallel_reduce(ITaskQueue& executor, Source_ const& source, Value_ const& identity, Combine_ const& combine,
+    ParallelOptions const& options = ParallelOptions()) {
+    return parallel_reduce(executor, source, identity, combine, [](auto const& element) -> Value_ { return element; }, options);
+}
+
+template <typename RandomIt_, typename Compare_ = std::less<typename std::iterator_traits<RandomIt_>::value_type>>
+void parallel_sort(ITaskQueue& executor, RandomIt_ first, RandomIt_ last, Compare_ const& compare = Compare_(),
+    ParallelOptions const& options = ParallelOptions()) {
+    const size_t size = std::distance(first, last);
+    const size_t run = std::max<size_t>(std::max<size_t>(1, options.SerialCutoff), (size + options.Concurrency - 1) / std::max<size_t>(1, options.Concurrency));
+    if (size <= run) {
+        std::sort(first, last, compare);
+        return;
+    }
+
+    ParallelOptions run_options = options;
+    run_options.Grain = 1;
+    run_options.SerialCutoff = 1;
+
+    const size_t runs = (size + run - 1) / run;
+    detail::parallel_run(executor, runs, run_options, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+            std::sort(first + i * run, first + std::min(size, (i + 1) * run), compare);
+    });
+
+    for (size_t width = run; width < size; width *= 2) {
+        const size_t merges = (size + 2 * width - 1) / (2 * width);
+        detail::parallel_run(executor, merges, run_options, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                const size_t middle = std::min(size, i * 2 * width + width);
+                std::inplace_merge(first + i * 2 * width, first + middle, first + std::min(size, (i + 1) * 2 * width), compare);
+            }
+        });
+    }
+}
+
+template <typename Container_, typename Compare_ = std::less<typename Container_::value_type>>
+void parallel_sort(ITaskQueue& executor, Container_& container, Compare_ const& compare = Compare_(), ParallelOptions const& options = ParallelOptions()) {
+    parallel_sort(executor, std::begin(container), std::end(container), compare, options);
+}
+}
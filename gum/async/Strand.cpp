@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) Vladimir Golubev
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <gum/async/Strand.h>
+
+#include <gum/Try.h>
+#include <gum/concurrency/MpscQueue.h>
+#include <gum/smartpointer/UniquePtr.h>
+
+#include <thread>
+
+namespace gum {
+
+class Strand::Impl {
+    struct TaskNode : public MpscQueueHook {
+        Task task;
+
+      public:
+        TaskNode(Task&& task_)
+            : task(std::move(task_)) {}
+    };
+    GUM_DECLARE_UNIQUE_PTR(TaskNode);
+
+  private:
+    static Logger _logger;
+
+    ITaskQueueRef _executor;
+    size_t _batch_size;
+
+    IntrusiveMpscQueue<TaskNode> _queue;
+    std::atomic<size_t> _pending;
+
+  public:
+    Impl(ITaskQueueRef const& executor, size_t batch_size)
+        : _executor(executor)
+        , _batch_size(batch_size)
+        , _pending(0) {
+        GUM_CHECK(_batch_size, ArgumentException("batch_size", _batch_size));
+    }
+
+    ~Impl() {
+        while (TaskNodeUniquePtr(_queue.pop()))
+            ;
+    }
+
+    void push(ImplRef const& self, Task&& task) {
+        _queue.push(new TaskNode(std::move(task)));
+
+        if (_pending.fetch_add(1, std::memory_order_acq_rel) == 0)
+            schedule(self);
+    }
+
+  private:
+    void schedule(ImplRef const& self) {
+        _executor->push([self] { self->drain(self); });
+    }
+
+    void drain(ImplRef const& self) {
+        for (size_t i = 0; i < _batch_size; ++i) {
+            const TaskNodeUniquePtr node = pop();
+            GUM_TRY_LEVEL("Uncaught exception in strand task", LogLevel::Error, node->task());
+
+            if (_pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                return;
+        }
+
+        schedule(self);
+    }
+
+    TaskNodeUniquePtr pop() {
+        TaskNode* node;
+        while (!(node = _queue.pop()))
+            std::this_thread::yield();
+        return node;
+    }
+};
+GUM_DEFINE_NAMED_LOGGER(Strand::Impl, Strand);
+
+Strand::Strand(ITaskQueueRef const& executor, size_t batch_size)
+    : _impl(make_shared_ref<Impl>(executor, batch_size)) {}
+
+void Strand::push(Task&& task) {
+    _impl->push(_impl, std::move(task));
+}
+}
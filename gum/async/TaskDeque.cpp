@@ -0,0 +1,209 @@
+/*
+ * Copyright (c) Vladimir Golubev
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <gum/async/TaskDeque.h>
+
+namespace gum {
+
+TaskDeque::TaskDeque(TaskQueueLimits const& limits)
+    : _limits(limits)
+    , _front_sequence() {}
+
+PushResult TaskDeque::try_push(Task&& task) {
+    return do_push(std::move(task), nullptr, nullptr);
+}
+
+PushResult TaskDeque::try_push(CoalescingKey key, Task&& task) {
+    return do_push(std::move(task), key, nullptr);
+}
+
+PushResult TaskDeque::push(Task&& task, ICancellationHandle& handle) {
+    return do_push(std::move(task), nullptr, make_optional<ICancellationHandle&>(handle));
+}
+
+PushResult TaskDeque::push(CoalescingKey key, Task&& task, ICancellationHandle& handle) {
+    return do_push(std::move(task), key, make_optional<ICancellationHandle&>(handle));
+}
+
+Optional<TaskDeque::Task> TaskDeque::try_pop() {
+    MutexLock l(_mutex);
+
+    if (_tasks.empty())
+        return nullptr;
+
+    return do_pop();
+}
+
+Optional<TaskDeque::Task> TaskDeque::pop(ICancellationHandle& handle) {
+    MutexLock l(_mutex);
+
+    if (!_tasks.empty())
+        return do_pop();
+
+    _not_empty.wait(_mutex, [this] { return !_tasks.empty(); }, handle);
+    if (!handle)
+        return nullptr;
+
+    return do_pop();
+}
+
+Optional<TaskDeque::Task> TaskDeque::pop_for(Duration const& timeout, ICancellationHandle& handle) {
+    MutexLock l(_mutex);
+
+    if (!_tasks.empty())
+        return do_pop();
+
+    if (!_not_empty.wait_for(_mutex, timeout, [this] { return !_tasks.empty(); }, handle) || !handle)
+        return nullptr;
+
+    return do_pop();
+}
+
+TaskDeque::Tasks TaskDeque::pop_n(size_t count) {
+    Tasks tasks;
+
+    MutexLock l(_mutex);
+
+    if (count >= _tasks.size())
+        return do_pop_all();
+
+    while (count--)
+        tasks.push_back(do_pop());
+
+    return tasks;
+}
+
+TaskDeque::Tasks TaskDeque::pop_all() {
+    MutexLock l(_mutex);
+    return do_pop_all();
+}
+
+void TaskDeque::set_readiness_event(IReadinessEventPtr const& readiness_event) {
+    MutexLock l(_mutex);
+
+    _readiness_event = readiness_event;
+    if (_readiness_event && !_tasks.empty())
+        _readiness_event->set();
+}
+
+size_t TaskDeque::size() const {
+    MutexLock l(_mutex);
+    return _tasks.size();
+}
+
+PushResult TaskDeque::do_push(Task&& task, Optional<CoalescingKey> const& key, Optional<ICancellationHandle&> handle) {
+    Task displaced;
+
+    MutexLock l(_mutex);
+
+    const bool coalesce = key && is_coalescing();
+    if (coalesce) {
+        auto const iter = _coalescing_index.find(*key);
+        if (iter != _coalescing_index.end()) {
+            displaced = std::move(_tasks[iter->second - _front_sequence]);
+            _tasks[iter->second - _front_sequence] = std::move(task);
+            return PushResult::Coalesced;
+        }
+    }
+
+    PushResult result = PushResult::Queued;
+    if (is_full()) {
+        switch (_limits.get_overflow_policy()) {
+        case OverflowPolicy::Block:
+            if (!handle)
+                return PushResult::Rejected;
+
+            _not_full.wait(_mutex, [this] { return !is_full(); }, *handle);
+            if (!*handle)
+                return PushResult::Cancelled;
+            break;
+        case OverflowPolicy::DropOldest:
+            displaced = do_pop();
+            result = PushResult::DisplacedOldest;
+            break;
+        case OverflowPolicy::Reject:
+        case OverflowPolicy::Coalesce:
+            return PushResult::Rejected;
+        }
+    }
+
+    if (coalesce)
+        _coalescing_index[*key] = _front_sequence + _tasks.size();
+    if (is_coalescing())
+        _task_keys.push_back(coalesce ? key : nullptr);
+
+    _tasks.push_back(std::move(task));
+    _not_empty.broadcast();
+
+    if (_readiness_event && _tasks.size() == 1)
+        _readiness_event->set();
+
+    return result;
+}
+
+TaskDeque::Task TaskDeque::do_pop() {
+    const bool was_full = is_full();
+
+    Task task = std::move(_tasks.front());
+    _tasks.pop_front();
+
+    if (is_coalescing()) {
+        Optional<CoalescingKey> const key = std::move(_task_keys.front());
+        _task_keys.pop_front();
+
+        if (key) {
+            auto const iter = _coalescing_index.find(*key);
+            if (iter != _coalescing_index.end() && iter->second == _front_sequence)
+                _coalescing_index.erase(iter);
+        }
+    }
+
+    ++_front_sequence;
+
+    if (was_full && may_block_producers())
+        _not_full.broadcast();
+
+    if (_readiness_event && _tasks.empty())
+        _readiness_event->reset();
+
+    return task;
+}
+
+TaskDeque::Tasks TaskDeque::do_pop_all() {
+    Tasks tasks;
+
+    const bool was_full = is_full();
+
+    _front_sequence += _tasks.size();
+    _tasks.swap(tasks);
+    _task_keys.clear();
+    _coalescing_index.clear();
+
+    if (was_full && may_block_producers())
+        _not_full.broadcast();
+
+    if (_readiness_event && !tasks.empty())
+        _readiness_event->reset();
+
+    return tasks;
+}
+}
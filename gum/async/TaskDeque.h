@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) Vladimir Golubev
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <gum/Optional.h>
+#include <gum/async/IReadinessEvent.h>
+#include <gum/async/ITaskQueue.h>
+#include <gum/async/TaskQueueLimits.h>
+#include <gum/concurrency/FutexConditionVariable.h>
+#include <gum/concurrency/Mutex.h>
+
+#include <deque>
+#include <unordered_map>
+
+namespace gum {
+
+class TaskDeque {
+  public:
+    using Task = ITaskQueue::Task;
+    using Tasks = std::deque<Task>;
+
+  private:
+    using TaskKeys = std::deque<Optional<CoalescingKey>>;
+    using CoalescingIndex = std::unordered_map<CoalescingKey, u64>;
+
+  private:
+    TaskQueueLimits _limits;
+
+    Tasks _tasks;
+    TaskKeys _task_keys;
+    CoalescingIndex _coalescing_index;
+    u64 _front_sequence;
+
+    IReadinessEventPtr _readiness_event;
+
+    Mutex _mutex;
+    FutexConditionVariable _not_empty;
+    FutexConditionVariable _not_full;
+
+  public:
+    TaskDeque(TaskQueueLimits const& limits = TaskQueueLimits());
+
+    PushResult try_push(Task&& task);
+    PushResult try_push(CoalescingKey key, Task&& task);
+
+    PushResult push(Task&& task, ICancellationHandle& handle);
+    PushResult push(CoalescingKey key, Task&& task, ICancellationHandle& handle);
+
+    Optional<Task> try_pop();
+    Optional<Task> pop(ICancellationHandle& handle);
+    Optional<Task> pop_for(Duration const& timeout, ICancellationHandle& handle);
+
+    Tasks pop_n(size_t count);
+    Tasks pop_all();
+
+    void set_readiness_event(IReadinessEventPtr const& readiness_event);
+
+    TaskQueueLimits get_limits() const {
+        return _limits;
+    }
+
+    size_t size() const;
+
+  private:
+    PushResult do_push(Task&& task, Optional<CoalescingKey> const& key, Optional<ICancellationHandle&> handle);
+
+    Task do_pop();
+    Tasks do_pop_all();
+
+    bool is_full() const {
+        return _tasks.size() >= _limits.get_capacity();
+    }
+
+    bool is_coalescing() const {
+        return _limits.get_overflow_policy() == OverflowPolicy::Coalesce;
+    }
+
+    bool may_block_producers() const {
+        return _limits.is_bounded() && _limits.get_overflow_policy() == OverflowPolicy::Block;
+    }
+};
+}
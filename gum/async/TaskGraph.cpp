@@ -0,0 +1,265 @@
+/*
+ * Copyright (c) Vladimir Golubev
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <gum/async/TaskGraph.h>
+
+#include <gum/concurrency/CancellationToken.h>
+#include <gum/concurrency/DummyCancellationHandle.h>
+#include <gum/concurrency/FutexConditionVariable.h>
+#include <gum/concurrency/Mutex.h>
+#include <gum/string/ToString.h>
+
+#include <atomic>
+#include <deque>
+#include <exception>
+#include <limits>
+#include <memory>
+
+namespace gum {
+
+GUM_DEFINE_LOGGER(TaskGraph);
+
+class TaskGraph::Run {
+    static constexpr NodeId NoNode = std::numeric_limits<NodeId>::max();
+
+  private:
+    TaskGraph const& _graph;
+    ITaskQueue& _executor;
+
+    std::unique_ptr<std::atomic<u32>[]> _pending;
+    std::vector<NodeReport> _reports;
+
+    CancellationToken _token;
+    std::atomic<bool> _failed{false};
+    std::exception_ptr _error;
+
+    SteadyClock::time_point _started;
+
+    Mutex _mutex;
+    FutexConditionVariable _changed;
+    std::deque<NodeId> _ready;
+    size_t _remaining;
+
+  public:
+    Run(TaskGraph const& graph, ITaskQueue& executor)
+        : _graph(graph)
+        , _executor(executor)
+        , _pending(new std::atomic<u32>[graph._nodes.size()])
+        , _reports(graph._nodes.size())
+        , _started(SteadyClock::now())
+        , _remaining(graph._nodes.size()) {
+        for (NodeId id = 0; id < graph._nodes.size(); ++id) {
+            _pending[id].store(graph._nodes[id].PredecessorCount, std::memory_order_relaxed);
+            _reports[id] = {graph._nodes[id].Name, NodeState::Skipped, Duration::zero(), Duration::zero()};
+        }
+    }
+
+    static void start(RunRef const& run) {
+        for (NodeId id = 0; id < run->_graph._nodes.size(); ++id)
+            if (!run->_graph._nodes[id].PredecessorCount)
+                run->schedule(run, id);
+    }
+
+    void cancel() {
+        _token.cancel();
+    }
+
+    static void wait(RunRef const& run) {
+        for (;;) {
+            if (run->run_one(run))
+                continue;
+
+            MutexLock l(run->_mutex);
+            if (!run->_remaining)
+                break;
+
+            run->_changed.wait(run->_mutex, [&] { return !run->_remaining || !run->_ready.empty(); }, *DummyCancellationHandle());
+        }
+    }
+
+    Report get_report(bool cancelled) {
+        return {cancelled, elapsed_since_start(), std::move(_reports), _error};
+    }
+
+  private:
+    void schedule(RunRef const& run, NodeId id) {
+        {
+            MutexLock l(_mutex);
+            _ready.push_back(id);
+        }
+        _changed.broadcast();
+
+        _executor.push([run] { run->run_one(run); });
+    }
+
+    bool run_one(RunRef const& run) {
+        NodeId id;
+        {
+            MutexLock l(_mutex);
+            if (_ready.empty())
+                return false;
+
+            id = _ready.front();
+            _ready.pop_front();
+        }
+
+        execute(run, id);
+        return true;
+    }
+
+    void execute(RunRef const& run, NodeId id) {
+        while (id != NoNode) {
+            execute_node(id);
+
+            NodeId next = NoNode;
+            for (NodeId successor : _graph._nodes[id].Successors) {
+                if (_pending[successor].fetch_sub(1, std::memory_order_acq_rel) != 1)
+                    continue;
+
+                if (next == NoNode)
+                    next = successor;
+                else
+                    schedule(run, successor);
+            }
+
+            finish_node();
+            id = next;
+        }
+    }
+
+    void finish_node() {
+        bool finished;
+        {
+            MutexLock l(_mutex);
+            finished = !--_remaining;
+        }
+
+        if (finished)
+            _changed.broadcast();
+    }
+
+    void execute_node(NodeId id) {
+        if (!_token)
+            return;
+
+        NodeReport& report = _reports[id];
+        report.Started = elapsed_since_start();
+        try {
+            _graph._nodes[id].Body(_token);
+            report.State = NodeState::Completed;
+        } catch (...) {
+            report.State = NodeState::Failed;
+            if (!_failed.exchange(true)) {
+                _error = std::current_exception();
+                _token.cancel();
+            }
+        }
+        report.Elapsed = elapsed_since_start() - report.Started;
+    }
+
+    Duration elapsed_since_start() const {
+        return std::chrono::duration_cast<Duration>(SteadyClock::now() - _started);
+    }
+};
+
+TaskGraph::TaskGraph(String const& name)
+    : _name(name) {}
+
+TaskGraph::NodeId TaskGraph::add_node(String const& name, Task const& task) {
+    _nodes.push_back({name, task, {}, 0});
+    return _nodes.size() - 1;
+}
+
+void TaskGraph::add_edge(NodeId from, NodeId to) {
+    GUM_CHECK_INDEX(from, _nodes.size());
+    GUM_CHECK_INDEX(to, _nodes.size());
+    GUM_CHECK(!is_reachable(to, from), TaskGraphCycleException(String() << _nodes[from].Name << " -> " << _nodes[to].Name));
+
+    _nodes[from].Successors.push_back(to);
+    ++_nodes[to].PredecessorCount;
+}
+
+size_t TaskGraph::size() const {
+    return _nodes.size();
+}
+
+TaskGraph::Report TaskGraph::run(ITaskQueue& executor, ICancellationHandle& handle) const {
+    Report report = try_run(executor, handle);
+    if (report.Error)
+        std::rethrow_exception(report.Error);
+    return report;
+}
+
+TaskGraph::Report TaskGraph::try_run(ITaskQueue& executor, ICancellationHandle& handle) const {
+    if (_nodes.empty())
+        return {!handle, Duration::zero(), {}, nullptr};
+
+    const auto run = make_shared_ref<Run>(*this, executor);
+    const Token cancellation = handle.on_cancelled([run] { run->cancel(); });
+    if (!handle)
+        run->cancel();
+
+    Run::start(run);
+    Run::wait(run);
+
+    Report report = run->get_report(!handle);
+
+    _logger.debug() << *this << " finished: " << report;
+    return report;
+}
+
+String TaskGraph::to_string() const {
+    return String() << "TaskGraph " << _name << " (" << _nodes.size() << " nodes)";
+}
+
+bool TaskGraph::is_reachable(NodeId from, NodeId to) const {
+    std::vector<bool> visited(_nodes.size());
+    std::vector<NodeId> stack = {from};
+
+    while (!stack.empty()) {
+        const NodeId id = stack.back();
+        stack.pop_back();
+
+        if (id == to)
+            return true;
+        if (visited[id])
+            continue;
+
+        visited[id] = true;
+        stack.insert(stack.end(), _nodes[id].Successors.begin(), _nodes[id].Successors.end());
+    }
+
+    return false;
+}
+
+String TaskGraph::Report::to_string() const {
+    String result = String() << "{ elapsed: " << std::chrono::duration_cast<Microseconds>(Elapsed).count() << "us";
+    if (Cancelled)
+        result << ", cancelled";
+    if (Error)
+        result << ", failed";
+    for (auto const& node : Nodes)
+        result << ", " << node.Name << ": " << node.State << " +" << std::chrono::duration_cast<Microseconds>(node.Started).count() << "us/"
+               << std::chrono::duration_cast<Microseconds>(node.Elapsed).count() << "us";
+    return result << " }";
+}
+}
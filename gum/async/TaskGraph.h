@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) Vladimir Golubev
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <gum/Enum.h>
+#include <gum/async/ITaskQueue.h>
+#include <gum/concurrency/ICancellationToken.h>
+#include <gum/log/Logger.h>
+#include <gum/string/String.h>
+#include <gum/time/Types.h>
+
+#include <exception>
+#include <vector>
+
+namespace gum {
+
+GUM_DECLARE_EXCEPTION(TaskGraphCycleException, "Task graph cycle");
+
+class TaskGraph {
+    class Run;
+    GUM_DECLARE_REF(Run);
+
+  public:
+    using NodeId = size_t;
+    using Task = std::function<void(ICancellationHandle&)>;
+
+    GUM_ENUM(NodeState, Completed, Skipped, Failed);
+
+    struct NodeReport {
+        String Name;
+        NodeState State;
+        Duration Started;
+        Duration Elapsed;
+    };
+
+    struct Report {
+        bool Cancelled;
+        Duration Elapsed;
+        std::vector<NodeReport> Nodes;
+        std::exception_ptr Error; // First node failure, if any
+
+        String to_string() const;
+    };
+
+  private:
+    struct Node {
+        String Name;
+        Task Body;
+        std::vector<NodeId> Successors;
+        u32 PredecessorCount;
+    };
+
+  private:
+    static Logger _logger;
+
+    String _name;
+    std::vector<Node> _nodes;
+
+  public:
+    explicit TaskGraph(String const& name);
+
+    NodeId add_node(String const& name, Task const& task);
+    void add_edge(NodeId from, NodeId to);
+
+    size_t size() const;
+
+    // Rethrows the first node failure
+    Report run(ITaskQueue& executor, ICancellationHandle& handle) const;
+    // Returns the partial report with the first node failure in Report::Error instead of throwing it
+    Report try_run(ITaskQueue& executor, ICancellationHandle& handle) const;
+
+    String to_string() const;
+
+  private:
+    bool is_reachable(NodeId from, NodeId to) const;
+};
+}
@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) Vladimir Golubev
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <gum/async/TaskGroup.h>
+
+#include <gum/Try.h>
+#include <gum/concurrency/CancellationToken.h>
+#include <gum/concurrency/DummyCancellationHandle.h>
+#include <gum/concurrency/FutexConditionVariable.h>
+#include <gum/concurrency/Mutex.h>
+
+#include <deque>
+#include <exception>
+#include <utility>
+
+namespace gum {
+
+GUM_DEFINE_LOGGER(TaskGroup);
+
+class TaskGroup::Impl {
+    ITaskQueue& _executor;
+
+    CancellationToken _token;
+
+    Mutex _mutex;
+    FutexConditionVariable _changed;
+    std::deque<Task> _pending;
+    size_t _outstanding;
+    std::exception_ptr _error;
+
+  public:
+    explicit Impl(ITaskQueue& executor)
+        : _executor(executor)
+        , _outstanding(0) {}
+
+    static void spawn(ImplRef const& impl, Task const& task) {
+        {
+            MutexLock l(impl->_mutex);
+            impl->_pending.push_back(task);
+            ++impl->_outstanding;
+        }
+        impl->_changed.broadcast();
+
+        impl->_executor.push([impl] { impl->run_one(); });
+    }
+
+    bool wait(ICancellationHandle& handle) {
+        for (;;) {
+            if (run_one())
+                continue;
+
+            {
+                MutexLock l(_mutex);
+                if (!_outstanding) {
+                    if (_error)
+                        std::rethrow_exception(std::exchange(_error, nullptr));
+                    return (bool)handle && (bool)_token;
+                }
+
+                if (_pending.empty())
+                    _changed.wait(_mutex, [this] { return !_outstanding || !_pending.empty(); }, handle);
+            }
+
+            if (!handle) {
+                cancel();
+                return false;
+            }
+        }
+    }
+
+    void cancel() {
+        _token.cancel();
+    }
+
+    bool is_cancelled() const {
+        return !_token;
+    }
+
+  private:
+    bool run_one() {
+        Task task;
+        {
+            MutexLock l(_mutex);
+            if (_pending.empty())
+                return false;
+
+            task = std::move(_pending.front());
+            _pending.pop_front();
+        }
+
+        std::exception_ptr error;
+        if (_token) {
+            try {
+                task(_token);
+            } catch (...) {
+                error = std::current_exception();
+            }
+        }
+
+        {
+            MutexLock l(_mutex);
+            if (error && !_error) {
+                _error = error;
+                _token.cancel();
+            }
+            --_outstanding;
+        }
+        _changed.broadcast();
+        return true;
+    }
+};
+
+TaskGroup::TaskGroup(ITaskQueue& executor)
+    : _impl(make_shared_ref<Impl>(executor)) {}
+
+TaskGroup::TaskGroup(ITaskQueue& executor, ICancellationHandle& parent)
+    : TaskGroup(executor) {
+    ImplRef const impl = _impl;
+    _parent_connection = parent.on_cancelled([impl] { impl->cancel(); });
+}
+
+TaskGroup::~TaskGroup() {
+    _parent_connection.release();
+
+    _impl->cancel();
+    GUM_TRY_LEVEL("Task group failed", LogLevel::Warning, _impl->wait(*DummyCancellationHandle()));
+}
+
+void TaskGroup::spawn(Task const& task) {
+    Impl::spawn(_impl, task);
+}
+
+bool TaskGroup::wait(ICancellationHandle& handle) {
+    ImplRef const impl = _impl;
+    const Token connection = handle.on_cancelled([impl] { impl->cancel(); });
+    return _impl->wait(handle);
+}
+
+void TaskGroup::cancel() {
+    _impl->cancel();
+}
+
+bool TaskGroup::is_cancelled() const {
+    return _impl->is_cancelled();
+}
+}
@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) Vladimir Golubev
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <gum/async/ITaskQueue.h>
+#include <gum/concurrency/ICancellationToken.h>
+#include <gum/log/Logger.h>
+#include <gum/token/Token.h>
+
+namespace gum {
+
+class TaskGroup {
+    class Impl;
+    GUM_DECLARE_REF(Impl);
+
+  public:
+    using Task = std::function<void(ICancellationHandle&)>;
+
+  private:
+    static Logger _logger;
+
+    ImplRef _impl;
+    Token _parent_connection;
+
+  public:
+    explicit TaskGroup(ITaskQueue& executor);
+    TaskGroup(ITaskQueue& executor, ICancellationHandle& parent);
+    ~TaskGroup();
+
+    TaskGroup(TaskGroup const&) = delete;
+    TaskGroup& operator=(TaskGroup const&) = delete;
+
+    void spawn(Task const& task);
+
+    bool wait(ICancellationHandle& handle);
+    void cancel();
+
+    bool is_cancelled() const;
+};
+}
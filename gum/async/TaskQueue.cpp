@@ -23,29 +23,111 @@
 #include <gum/async/TaskQueue.h>
 
 #include <gum/Try.h>
+#include <gum/async/CurrentTaskQueue.h>
+#include <gum/concurrency/DummyCancellationHandle.h>
 #include <gum/functional/Invoker.h>
+#include <gum/maybe/Maybe.h>
+#include <gum/time/ElapsedTime.h>
+
+#ifdef GUM_HAS_EVENTFD
+#include <gum/backend/posix/async/EventDescriptor.h>
+#endif
 
 #include <algorithm>
 
 namespace gum {
 
+namespace {
+
+#ifdef GUM_HAS_EVENTFD
+using ReadinessEvent = posix::EventDescriptor;
+GUM_DECLARE_REF(ReadinessEvent);
+#endif
+}
+
 GUM_DEFINE_LOGGER(TaskQueue);
 
+TaskQueue::TaskQueue(TaskQueueLimits const& limits)
+    : _queue(limits) {}
+
 void TaskQueue::push(Task&& task) {
-    MutexLock l(_mutex);
-    _queue.push_back([task = std::move(task)] { GUM_TRY_LEVEL("Uncaught exception in queued task", LogLevel::Error, task()); });
+    const PushResult result = _queue.push(wrap(std::move(task)), *DummyCancellationHandle());
+    GUM_CHECK(result != PushResult::Rejected, TaskQueueOverflowException(String() << "limits: " << _queue.get_limits()));
+}
+
+PushResult TaskQueue::try_push(Task&& task) {
+    return _queue.try_push(wrap(std::move(task)));
+}
+
+PushResult TaskQueue::try_push(CoalescingKey key, Task&& task) {
+    return _queue.try_push(key, wrap(std::move(task)));
+}
+
+PushResult TaskQueue::push(Task&& task, ICancellationHandle& handle) {
+    return _queue.push(wrap(std::move(task)), handle);
+}
+
+PushResult TaskQueue::push(CoalescingKey key, Task&& task, ICancellationHandle& handle) {
+    return _queue.push(key, wrap(std::move(task)), handle);
+}
+
+TaskQueueLimits TaskQueue::get_limits() const {
+    return _queue.get_limits();
+}
+
+size_t TaskQueue::size() const {
+    return _queue.size();
 }
 
 void TaskQueue::run() {
-    Queue queue;
-    {
-        MutexLock l(_mutex);
+    const CurrentTaskQueue::Scope scope(*this);
+
+    const TaskDeque::Tasks tasks = _queue.pop_all();
+    std::for_each(tasks.begin(), tasks.end(), Invoker());
+}
+
+size_t TaskQueue::run_n(size_t max_tasks) {
+    const CurrentTaskQueue::Scope scope(*this);
 
-        if (_queue.empty())
-            return;
-        _queue.swap(queue);
+    const TaskDeque::Tasks tasks = _queue.pop_n(max_tasks);
+    std::for_each(tasks.begin(), tasks.end(), Invoker());
+    return tasks.size();
+}
+
+size_t TaskQueue::run_for(Duration const& budget) {
+    const CurrentTaskQueue::Scope scope(*this);
+    const GenericElapsedTime<SteadyClock> elapsed;
+
+    size_t count = 0;
+    while (elapsed.elapsed() < budget && maybe(_queue.try_pop()).and_(Invoker()))
+        ++count;
+    return count;
+}
+
+void TaskQueue::run_until(ICancellationHandle& handle) {
+    const CurrentTaskQueue::Scope scope(*this);
+
+    while (maybe(_queue.pop(handle)).and_(Invoker()))
+        ;
+}
+
+int TaskQueue::get_readiness_descriptor() {
+#ifdef GUM_HAS_EVENTFD
+    MutexLock l(_readiness_descriptor_mutex);
+
+    if (!_readiness_descriptor) {
+        const ReadinessEventRef readiness_event = make_shared_ref<ReadinessEvent>();
+        _queue.set_readiness_event(readiness_event);
+        _readiness_descriptor = readiness_event->get_handle();
     }
 
-    std::for_each(queue.begin(), queue.end(), Invoker());
+    return *_readiness_descriptor;
+#else
+    GUM_THROW(NotImplementedException("Readiness descriptor"));
+#endif
+}
+
+TaskQueue::Task TaskQueue::wrap(Task&& task) {
+    return [task = std::move(task)] { GUM_TRY_LEVEL("Uncaught exception in queued task", LogLevel::Error, task()); };
 }
 }
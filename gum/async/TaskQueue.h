@@ -22,28 +22,45 @@
 
 #pragma once
 
-#include <gum/Optional.h>
-#include <gum/async/ITaskQueue.h>
-#include <gum/concurrency/Mutex.h>
+#include <gum/async/IBoundedTaskQueue.h>
+#include <gum/async/TaskDeque.h>
 #include <gum/log/Logger.h>
-
-#include <deque>
+#include <gum/time/Types.h>
 
 namespace gum {
 
-class TaskQueue : public virtual ITaskQueue {
-    using Queue = std::deque<Task>;
-
+class TaskQueue : public virtual IBoundedTaskQueue {
   private:
     static Logger _logger;
 
-    Queue _queue;
-    Mutex _mutex;
+    TaskDeque _queue;
+
+    Optional<int> _readiness_descriptor;
+    Mutex _readiness_descriptor_mutex;
 
   public:
+    TaskQueue(TaskQueueLimits const& limits = TaskQueueLimits());
+
     void push(Task&& task) override;
 
+    PushResult try_push(Task&& task) override;
+    PushResult try_push(CoalescingKey key, Task&& task) override;
+
+    PushResult push(Task&& task, ICancellationHandle& handle) override;
+    PushResult push(CoalescingKey key, Task&& task, ICancellationHandle& handle) override;
+
+    TaskQueueLimits get_limits() const override;
+    size_t size() const override;
+
     void run();
+    size_t run_n(size_t max_tasks);
+    size_t run_for(Duration const& budget);
+    void run_until(ICancellationHandle& handle);
+
+    int get_readiness_descriptor();
+
+  private:
+    static Task wrap(Task&& task);
 };
 GUM_DECLARE_PTR(TaskQueue);
 GUM_DECLARE_REF(TaskQueue);
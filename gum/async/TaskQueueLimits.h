@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) Vladimir Golubev
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <gum/Enum.h>
+#include <gum/string/ToString.h>
+
+#include <limits>
+
+namespace gum {
+
+GUM_ENUM(OverflowPolicy, Block, Reject, DropOldest, Coalesce);
+
+GUM_ENUM(PushResult, Queued, Coalesced, DisplacedOldest, Rejected, Cancelled);
+
+using CoalescingKey = u64;
+
+class TaskQueueLimits {
+    using Self = TaskQueueLimits;
+
+  private:
+    size_t _capacity;
+    OverflowPolicy _overflow_policy;
+
+  public:
+    TaskQueueLimits()
+        : _capacity(std::numeric_limits<size_t>::max())
+        , _overflow_policy(OverflowPolicy::Block) {}
+
+    TaskQueueLimits(size_t capacity, OverflowPolicy overflow_policy)
+        : _capacity(capacity)
+        , _overflow_policy(overflow_policy) {
+        GUM_CHECK(_capacity, ArgumentException("capacity", _capacity));
+    }
+
+    static Self unbounded() {
+        return Self();
+    }
+
+    size_t get_capacity() const {
+        return _capacity;
+    }
+
+    OverflowPolicy get_overflow_policy() const {
+        return _overflow_policy;
+    }
+
+    bool is_bounded() const {
+        return _capacity != std::numeric_limits<size_t>::max();
+    }
+
+    String to_string() const {
+        if (!is_bounded())
+            return "{ unbounded }";
+        return String() << "{ capacity: " << _capacity << ", overflow_policy: " << _overflow_policy << " }";
+    }
+};
+}
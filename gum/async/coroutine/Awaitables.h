@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) Vladimir Golubev
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <gum/async/ITaskQueue.h>
+#include <gum/concurrency/ICancellationToken.h>
+
+#include <atomic>
+#include <coroutine>
+
+namespace gum {
+
+namespace detail {
+
+class AwaitGate {
+    enum class State : u8 { Idle, Suspended, Completed };
+
+  private:
+    std::atomic<State> _state;
+
+  public:
+    AwaitGate()
+        : _state(State::Idle) {}
+
+    void reset() {
+        _state = State::Idle;
+    }
+
+    bool suspend() {
+        return _state.exchange(State::Suspended) != State::Completed;
+    }
+
+    bool complete() {
+        return _state.exchange(State::Completed) == State::Suspended;
+    }
+};
+
+inline void resume_on(ITaskQueue& queue, std::coroutine_handle<> coroutine) {
+    queue.push([coroutine] { coroutine.resume(); });
+}
+}
+
+class ScheduleOnAwaiter {
+    ITaskQueueRef _queue;
+
+  public:
+    ScheduleOnAwaiter(ITaskQueueRef const& queue)
+        : _queue(queue) {}
+
+    bool await_ready() const noexcept {
+        return false;
+    }
+
+    void await_suspend(std::coroutine_handle<> coroutine) {
+        detail::resume_on(*_queue, coroutine);
+    }
+
+    void await_resume() const noexcept {}
+};
+
+class CancellationAwaiter {
+    ICancellationHandle& _handle;
+    ITaskQueueRef _resume_queue;
+
+    std::coroutine_handle<> _coroutine;
+    detail::AwaitGate _gate;
+    Token _token;
+
+  public:
+    CancellationAwaiter(ICancellationHandle& handle, ITaskQueueRef const& resume_queue)
+        : _handle(handle)
+        , _resume_queue(resume_queue) {}
+
+    bool await_ready() const noexcept {
+        return !_handle;
+    }
+
+    bool await_suspend(std::coroutine_handle<> coroutine) {
+        _coroutine = coroutine;
+        _token = _handle.on_cancelled([this] {
+            if (_gate.complete())
+                detail::resume_on(*_resume_queue, _coroutine);
+        });
+
+        if (!_token)
+            return (bool)_handle;
+
+        return _gate.suspend();
+    }
+
+    void await_resume() const noexcept {}
+};
+
+inline ScheduleOnAwaiter schedule_on(ITaskQueueRef const& queue) {
+    return ScheduleOnAwaiter(queue);
+}
+
+inline CancellationAwaiter cancelled(ICancellationHandle& handle, ITaskQueueRef const& resume_queue) {
+    return CancellationAwaiter(handle, resume_queue);
+}
+}
@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) Vladimir Golubev
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <gum/async/coroutine/FrameAllocator.h>
+
+#include <array>
+#include <new>
+
+namespace gum {
+
+namespace {
+
+thread_local bool t_frame_cache_destroyed = false;
+
+class FrameCache {
+    struct FreeFrame {
+        FreeFrame* next;
+    };
+
+    struct Bucket {
+        FreeFrame* head = nullptr;
+        size_t count = 0;
+    };
+
+    static constexpr size_t BucketCount = FrameAllocator::MaxRecycledSize / FrameAllocator::Granularity;
+
+  private:
+    std::array<Bucket, BucketCount> _buckets;
+
+  public:
+    ~FrameCache() {
+        t_frame_cache_destroyed = true;
+
+        for (auto& bucket : _buckets)
+            while (bucket.head)
+                ::operator delete(pop(bucket));
+    }
+
+    static bool is_recyclable(size_t size) {
+        return size <= FrameAllocator::MaxRecycledSize;
+    }
+
+    static size_t get_block_size(size_t size) {
+        return (get_bucket_index(size) + 1) * FrameAllocator::Granularity;
+    }
+
+    void* allocate(size_t size) {
+        Bucket& bucket = _buckets[get_bucket_index(size)];
+        return bucket.head ? pop(bucket) : ::operator new(get_block_size(size));
+    }
+
+    void deallocate(void* frame, size_t size) {
+        Bucket& bucket = _buckets[get_bucket_index(size)];
+        if (bucket.count >= FrameAllocator::MaxCachedPerSize) {
+            ::operator delete(frame);
+            return;
+        }
+
+        bucket.head = new (frame) FreeFrame{bucket.head};
+        ++bucket.count;
+    }
+
+  private:
+    static size_t get_bucket_index(size_t size) {
+        return size ? (size - 1) / FrameAllocator::Granularity : 0;
+    }
+
+    static void* pop(Bucket& bucket) {
+        FreeFrame* const frame = bucket.head;
+        bucket.head = frame->next;
+        --bucket.count;
+        return frame;
+    }
+};
+
+FrameCache* get_frame_cache() {
+    static thread_local FrameCache cache;
+    return t_frame_cache_destroyed ? nullptr : &cache;
+}
+}
+
+void* FrameAllocator::allocate(size_t size) {
+    if (!FrameCache::is_recyclable(size))
+        return ::operator new(size);
+
+    FrameCache* const cache = get_frame_cache();
+    return cache ? cache->allocate(size) : ::operator new(FrameCache::get_block_size(size));
+}
+
+void FrameAllocator::deallocate(void* frame, size_t size) noexcept {
+    FrameCache* const cache = FrameCache::is_recyclable(size) ? get_frame_cache() : nullptr;
+    if (cache)
+        cache->deallocate(frame, size);
+    else
+        ::operator delete(frame);
+}
+}
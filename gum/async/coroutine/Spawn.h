@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) Vladimir Golubev
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <gum/Unit.h>
+#include <gum/async/Future.h>
+#include <gum/async/coroutine/Awaitables.h>
+#include <gum/async/coroutine/Task.h>
+
+#include <type_traits>
+
+namespace gum {
+
+namespace detail {
+
+struct DetachedTask {
+    struct promise_type {
+        static void* operator new(size_t size) {
+            return FrameAllocator::allocate(size);
+        }
+
+        static void operator delete(void* frame, size_t size) noexcept {
+            FrameAllocator::deallocate(frame, size);
+        }
+
+        DetachedTask get_return_object() const noexcept {
+            return {};
+        }
+
+        std::suspend_never initial_suspend() const noexcept {
+            return {};
+        }
+
+        std::suspend_never final_suspend() const noexcept {
+            return {};
+        }
+
+        void return_void() const noexcept {}
+
+        void unhandled_exception() const noexcept {
+            std::terminate();
+        }
+    };
+};
+
+template <typename Value_>
+using SpawnedValue = std::conditional_t<std::is_void<Value_>::value, Unit, Value_>;
+
+template <typename Value_>
+Task<ErrorOr<SpawnedValue<Value_>>> capture_result(ITaskQueueRef queue, Task<Value_> task) {
+    try {
+        co_await schedule_on(queue);
+
+        if constexpr (std::is_void<Value_>::value) {
+            co_await std::move(task);
+            co_return Unit();
+        } else
+            co_return co_await std::move(task);
+    } catch (...) {
+        co_return capture_exception();
+    }
+}
+
+template <typename Value_>
+DetachedTask run_detached(ITaskQueueRef queue, Task<Value_> task, Promise<SpawnedValue<Value_>> promise) {
+    auto result = co_await capture_result(std::move(queue), std::move(task));
+    promise.set_result(std::move(result));
+}
+}
+
+template <typename Value_>
+Future<detail::SpawnedValue<Value_>> spawn(ITaskQueueRef const& queue, Task<Value_>&& task) {
+    Promise<detail::SpawnedValue<Value_>> promise;
+    Future<detail::SpawnedValue<Value_>> future = promise.get_future();
+
+    detail::run_detached(queue, std::move(task), std::move(promise));
+    return future;
+}
+}
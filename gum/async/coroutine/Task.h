@@ -0,0 +1,201 @@
+/*
+ * Copyright (c) Vladimir Golubev
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <gum/Optional.h>
+#include <gum/async/coroutine/FrameAllocator.h>
+
+#include <coroutine>
+#include <exception>
+#include <utility>
+
+namespace gum {
+
+template <typename Value_ = void>
+class Task;
+
+namespace detail {
+
+class TaskPromiseBase {
+    struct FinalAwaiter {
+        bool await_ready() const noexcept {
+            return false;
+        }
+
+        template <typename Promise_>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise_> coroutine) noexcept {
+            std::coroutine_handle<> const continuation = coroutine.promise()._continuation;
+            return continuation ? continuation : std::noop_coroutine();
+        }
+
+        void await_resume() const noexcept {}
+    };
+
+  private:
+    std::coroutine_handle<> _continuation;
+    std::exception_ptr _exception;
+
+  public:
+    static void* operator new(size_t size) {
+        return FrameAllocator::allocate(size);
+    }
+
+    static void operator delete(void* frame, size_t size) noexcept {
+        FrameAllocator::deallocate(frame, size);
+    }
+
+    std::suspend_always initial_suspend() const noexcept {
+        return {};
+    }
+
+    FinalAwaiter final_suspend() const noexcept {
+        return {};
+    }
+
+    void unhandled_exception() noexcept {
+        _exception = std::current_exception();
+    }
+
+    void set_continuation(std::coroutine_handle<> continuation) {
+        _continuation = continuation;
+    }
+
+  protected:
+    void rethrow_if_failed() const {
+        if (_exception)
+            std::rethrow_exception(_exception);
+    }
+};
+
+template <typename Value_>
+class TaskPromise : public TaskPromiseBase {
+    Optional<Value_> _value;
+
+  public:
+    Task<Value_> get_return_object() noexcept;
+
+    template <typename Value__>
+    void return_value(Value__&& value) {
+        _value = Value_(std::forward<Value__>(value));
+    }
+
+    Value_ take_value() {
+        rethrow_if_failed();
+        return std::move(*_value);
+    }
+};
+
+template <>
+class TaskPromise<void> : public TaskPromiseBase {
+  public:
+    Task<void> get_return_object() noexcept;
+
+    void return_void() const noexcept {}
+
+    void take_value() const {
+        rethrow_if_failed();
+    }
+};
+}
+
+template <typename Value_>
+class Task {
+  public:
+    using promise_type = detail::TaskPromise<Value_>;
+    using Coroutine = std::coroutine_handle<promise_type>;
+
+  private:
+    class Awaiter {
+        Coroutine _coroutine;
+
+      public:
+        Awaiter(Coroutine coroutine)
+            : _coroutine(coroutine) {}
+
+        bool await_ready() const noexcept {
+            return _coroutine.done();
+        }
+
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept {
+            _coroutine.promise().set_continuation(awaiting);
+            return _coroutine;
+        }
+
+        Value_ await_resume() {
+            return _coroutine.promise().take_value();
+        }
+    };
+
+  private:
+    Coroutine _coroutine;
+
+  public:
+    explicit Task(Coroutine coroutine)
+        : _coroutine(coroutine) {}
+
+    Task(Task const&) = delete;
+    Task& operator=(Task const&) = delete;
+
+    Task(Task&& other) noexcept
+        : _coroutine(std::exchange(other._coroutine, nullptr)) {}
+
+    Task& operator=(Task&& other) noexcept {
+        if (this != &other) {
+            destroy();
+            _coroutine = std::exchange(other._coroutine, nullptr);
+        }
+        return *this;
+    }
+
+    ~Task() {
+        destroy();
+    }
+
+    Awaiter operator co_await() && {
+        GUM_CHECK(_coroutine, "Awaiting an empty task");
+        return Awaiter(_coroutine);
+    }
+
+    bool is_ready() const {
+        return !_coroutine || _coroutine.done();
+    }
+
+  private:
+    void destroy() {
+        if (_coroutine)
+            _coroutine.destroy();
+    }
+};
+
+namespace detail {
+
+template <typename Value_>
+Task<Value_> TaskPromise<Value_>::get_return_object() noexcept {
+    return Task<Value_>(std::coroutine_handle<TaskPromise<Value_>>::from_promise(*this));
+}
+
+inline Task<void> TaskPromise<void>::get_return_object() noexcept {
+    return Task<void>(std::coroutine_handle<TaskPromise<void>>::from_promise(*this));
+}
+}
+}
@@ -0,0 +1,365 @@
+/*
+ * Copyright (c) Vladimir Golubev
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <gum/async/fiber/Fiber.h>
+
+#include <gum/Try.h>
+#include <gum/concurrency/CancellationToken.h>
+#include <gum/concurrency/FutexConditionVariable.h>
+#include <gum/concurrency/ScopedCancellationCallback.h>
+#include <gum/concurrency/Thread.h>
+
+#include <algorithm>
+#include <map>
+#include <vector>
+
+namespace gum {
+
+namespace {
+
+thread_local Fiber* t_current_fiber = nullptr;
+}
+
+class Fiber::Scheduling {
+    using Timers = std::multimap<SteadyClock::time_point, FiberWaiter*>;
+
+  public:
+    using TimerId = Timers::iterator;
+
+  private:
+    static Logger _logger;
+
+    ITaskQueue& _executor;
+    FiberStackPoolRef _stacks;
+    Futex::Word _fiber_count;
+    CancellationToken _cancellation_token;
+
+    Mutex _mutex;
+    FutexConditionVariable _timers_changed;
+    Timers _timers;
+
+    Thread _timer_thread;
+
+  public:
+    Scheduling(ITaskQueue& executor, FiberSchedulerSettings const& settings)
+        : _executor(executor)
+        , _stacks(make_shared_ref<FiberStackPool>(settings.StackSize, settings.MaxCachedStacks))
+        , _fiber_count(0)
+        , _timer_thread("FiberTimers", [this](ICancellationHandle& handle) { timer_func(handle); }) {}
+
+    ITaskQueue& get_executor() const {
+        return _executor;
+    }
+
+    ICancellationHandle& get_cancellation_handle() {
+        return _cancellation_token;
+    }
+
+    FiberStackPoolRef const& get_stacks() const {
+        return _stacks;
+    }
+
+    void on_spawned() {
+        _fiber_count.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void on_finished() {
+        if (_fiber_count.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            Futex::wake_all(_fiber_count);
+    }
+
+    void shutdown() {
+        _cancellation_token.cancel();
+
+        for (u32 count; (count = _fiber_count.load(std::memory_order_acquire));)
+            if (!Futex::wait_for(_fiber_count, count, std::chrono::seconds(3)))
+                _logger.warning() << "Still waiting for " << _fiber_count.load() << " fibers to finish";
+    }
+
+    size_t get_fiber_count() const {
+        return _fiber_count.load(std::memory_order_relaxed);
+    }
+
+    TimerId add_timer(SteadyClock::time_point const& deadline, FiberWaiter& waiter) {
+        MutexLock l(_mutex);
+
+        const TimerId timer = _timers.emplace(deadline, &waiter);
+        if (timer == _timers.begin())
+            _timers_changed.signal();
+        return timer;
+    }
+
+    void remove_timer(TimerId const& timer) {
+        MutexLock l(_mutex);
+        _timers.erase(timer);
+    }
+
+  private:
+    void timer_func(ICancellationHandle& handle) {
+        std::vector<Fiber*> expired;
+
+        while (handle) {
+            {
+                MutexLock l(_mutex);
+
+                const auto now = SteadyClock::now();
+                Optional<SteadyClock::time_point> next_deadline;
+                for (auto iter = _timers.begin(); iter != _timers.end();) {
+                    if (iter->first > now) {
+                        next_deadline = iter->first;
+                        break;
+                    }
+
+                    if (iter->second->claim()) {
+                        expired.push_back(&iter->second->WaitingFiber);
+                        iter = _timers.erase(iter);
+                    } else
+                        ++iter;
+                }
+
+                if (expired.empty()) {
+                    if (next_deadline)
+                        _timers_changed.wait_for(_mutex, std::chrono::duration_cast<Duration>(*next_deadline - now), handle);
+                    else
+                        _timers_changed.wait(_mutex, handle);
+                }
+            }
+
+            for (Fiber* fiber : expired)
+                fiber->unpark();
+            expired.clear();
+        }
+    }
+};
+
+GUM_DEFINE_NAMED_LOGGER(Fiber::Scheduling, FiberScheduler);
+GUM_DEFINE_LOGGER(Fiber);
+
+Fiber::Fiber(SchedulingRef const& scheduling, Task const& task)
+    : _scheduling(scheduling)
+    , _task(task)
+    , _context(std::allocator_arg, PooledFiberStackAllocator(scheduling->get_stacks()), [this](Context&& caller) { return run(std::move(caller)); })
+    , _state(Running)
+    , _yielding(false)
+    , _finished(false) {}
+
+Fiber* Fiber::get_current() {
+    return t_current_fiber;
+}
+
+void Fiber::park() {
+    Fiber* const self = get_current();
+    GUM_CHECK(self, LogicError("Fiber::park() called outside of a fiber"));
+
+    u32 expected = RunningWithPermit;
+    if (self->_state.compare_exchange_strong(expected, Running, std::memory_order_acq_rel))
+        return;
+
+    self->switch_out();
+}
+
+void Fiber::yield() {
+    Fiber* const self = get_current();
+    GUM_CHECK(self, LogicError("Fiber::yield() called outside of a fiber"));
+
+    self->_yielding = true;
+    self->switch_out();
+}
+
+void Fiber::unpark() {
+    u32 state = _state.load(std::memory_order_acquire);
+    for (;;) {
+        if (state == Suspended) {
+            if (_state.compare_exchange_weak(state, Running, std::memory_order_acq_rel)) {
+                schedule();
+                return;
+            }
+        } else if (state == Running) {
+            if (_state.compare_exchange_weak(state, RunningWithPermit, std::memory_order_acq_rel))
+                return;
+        } else
+            return;
+    }
+}
+
+bool Fiber::is_finished() const {
+    return _finished_event.is_set();
+}
+
+bool Fiber::join(ICancellationHandle& handle) const {
+    Fiber* const self = get_current();
+    if (!self)
+        return _finished_event.wait(handle);
+
+    GUM_CHECK(self != this, LogicError("Fiber::join() called from the fiber itself"));
+
+    FiberWaiter waiter(*self);
+    {
+        MutexLock l(_joiners_mutex);
+        if (_finished_event.is_set())
+            return true;
+        _joiners.push_back(&waiter);
+    }
+
+    {
+        const auto waker = [&] {
+            if (waiter.claim()) {
+                remove_joiner(waiter);
+                self->unpark();
+            }
+        };
+        const ScopedCancellationCallback<decltype(waker)> callback(handle, waker);
+        if (!callback)
+            waker();
+
+        park();
+    }
+
+    return is_finished();
+}
+
+bool Fiber::sleep(Duration const& duration, ICancellationHandle& handle) {
+    FiberWaiter waiter(*this);
+    const Scheduling::TimerId timer = _scheduling->add_timer(SteadyClock::now() + duration, waiter);
+
+    const auto waker = [&] {
+        if (waiter.claim()) {
+            _scheduling->remove_timer(timer);
+            unpark();
+        }
+    };
+    const ScopedCancellationCallback<decltype(waker)> callback(handle, waker);
+    if (!callback)
+        waker();
+
+    park();
+    return (bool)handle;
+}
+
+void Fiber::schedule() {
+    _scheduling->get_executor().push([self = FiberRef(_self)] { self->resume(); });
+}
+
+void Fiber::resume() {
+    for (;;) {
+        Fiber* const previous = t_current_fiber;
+        t_current_fiber = this;
+        _context = std::move(_context).resume();
+        t_current_fiber = previous;
+
+        if (_finished) {
+            _scheduling->on_finished();
+            wake_joiners();
+            _self.reset();
+            return;
+        }
+
+        if (_yielding) {
+            _yielding = false;
+            schedule();
+            return;
+        }
+
+        u32 expected = Running;
+        if (_state.compare_exchange_strong(expected, Suspended, std::memory_order_acq_rel))
+            return;
+
+        _state.store(Running, std::memory_order_relaxed);
+    }
+}
+
+Fiber::Context Fiber::run(Context&& caller) {
+    _caller = std::move(caller);
+
+    GUM_TRY_LEVEL("Uncaught exception in fiber", LogLevel::Error, _task(_scheduling->get_cancellation_handle()));
+    _task = nullptr;
+
+    _finished = true;
+    return std::move(_caller);
+}
+
+void Fiber::switch_out() {
+    _caller = std::move(_caller).resume();
+}
+
+void Fiber::remove_joiner(FiberWaiter& waiter) const {
+    MutexLock l(_joiners_mutex);
+
+    auto const iter = std::find(_joiners.begin(), _joiners.end(), &waiter);
+    if (iter != _joiners.end())
+        _joiners.erase(iter);
+}
+
+void Fiber::wake_joiners() {
+    std::vector<Fiber*> woken;
+    {
+        MutexLock l(_joiners_mutex);
+        _finished_event.set();
+
+        for (FiberWaiter* waiter : _joiners)
+            if (waiter->claim())
+                woken.push_back(&waiter->WaitingFiber);
+        _joiners.clear();
+    }
+
+    for (Fiber* fiber : woken)
+        fiber->unpark();
+}
+
+FiberScheduler::FiberScheduler(ITaskQueueRef const& executor, FiberSchedulerSettings const& settings)
+    : _executor(executor)
+    , _scheduling(make_shared_ref<Fiber::Scheduling>(*executor, settings)) {}
+
+FiberScheduler::~FiberScheduler() {
+    _scheduling->shutdown();
+}
+
+FiberRef FiberScheduler::spawn(Fiber::Task const& task) {
+    const FiberRef fiber = make_shared_ref<Fiber>(_scheduling, task);
+    fiber->_self = fiber;
+
+    _scheduling->on_spawned();
+    fiber->schedule();
+    return fiber;
+}
+
+size_t FiberScheduler::get_fiber_count() const {
+    return _scheduling->get_fiber_count();
+}
+
+namespace this_fiber {
+
+bool is_fiber() {
+    return Fiber::get_current();
+}
+
+void yield() {
+    Fiber::yield();
+}
+
+bool sleep(Duration const& duration, ICancellationHandle& handle) {
+    Fiber* const self = Fiber::get_current();
+    GUM_CHECK(self, LogicError("this_fiber::sleep() called outside of a fiber"));
+    return self->sleep(duration, handle);
+}
+}
+}
@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) Vladimir Golubev
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <gum/async/ITaskQueue.h>
+#include <gum/async/fiber/FiberStackPool.h>
+#include <gum/concurrency/Futex.h>
+#include <gum/concurrency/ICancellationToken.h>
+#include <gum/concurrency/ManualResetEvent.h>
+#include <gum/concurrency/Mutex.h>
+#include <gum/log/Logger.h>
+#include <gum/time/Types.h>
+
+#include <boost/context/fiber.hpp>
+
+#include <atomic>
+#include <vector>
+
+namespace gum {
+
+class FiberScheduler;
+struct FiberWaiter;
+
+class Fiber {
+    friend class FiberScheduler;
+
+    using Context = boost::context::fiber;
+
+    class Scheduling;
+    GUM_DECLARE_REF(Scheduling);
+
+    enum State : u32 { Running, Suspended, RunningWithPermit };
+
+  public:
+    using Task = std::function<void(ICancellationHandle&)>;
+
+  private:
+    static Logger _logger;
+
+    SchedulingRef _scheduling;
+    Task _task;
+    Context _context;
+    Context _caller;
+
+    std::atomic<u32> _state;
+    bool _yielding;
+    bool _finished;
+    ManualResetEvent _finished_event;
+    mutable Mutex _joiners_mutex;
+    mutable std::vector<FiberWaiter*> _joiners;
+
+    SharedPtr<Fiber> _self;
+
+  public:
+    Fiber(SchedulingRef const& scheduling, Task const& task);
+
+    Fiber(Fiber const&) = delete;
+    Fiber& operator=(Fiber const&) = delete;
+
+    static Fiber* get_current();
+
+    static void park();
+    static void yield();
+
+    void unpark();
+
+    bool is_finished() const;
+
+    // Parks the calling fiber instead of blocking its thread when called from a fiber
+    bool join(ICancellationHandle& handle) const;
+
+    bool sleep(Duration const& duration, ICancellationHandle& handle);
+
+  private:
+    void schedule();
+    void resume();
+
+    Context run(Context&& caller);
+    void switch_out();
+
+    void remove_joiner(FiberWaiter& waiter) const;
+    void wake_joiners();
+};
+GUM_DECLARE_REF(Fiber);
+
+struct FiberWaiter {
+    Fiber& WaitingFiber;
+    std::atomic<bool> Claimed;
+
+  public:
+    explicit FiberWaiter(Fiber& fiber)
+        : WaitingFiber(fiber)
+        , Claimed(false) {}
+
+    bool claim() {
+        return !Claimed.exchange(true, std::memory_order_acq_rel);
+    }
+};
+
+struct FiberSchedulerSettings {
+    size_t StackSize = 64 * 1024;
+    size_t MaxCachedStacks = 1024;
+};
+
+class FiberScheduler {
+    ITaskQueueRef _executor;
+    Fiber::SchedulingRef _scheduling;
+
+  public:
+    FiberScheduler(ITaskQueueRef const& executor, FiberSchedulerSettings const& settings = FiberSchedulerSettings());
+    ~FiberScheduler();
+
+    FiberScheduler(FiberScheduler const&) = delete;
+    FiberScheduler& operator=(FiberScheduler const&) = delete;
+
+    FiberRef spawn(Fiber::Task const& task);
+
+    size_t get_fiber_count() const;
+};
+
+namespace this_fiber {
+
+bool is_fiber();
+
+void yield();
+bool sleep(Duration const& duration, ICancellationHandle& handle);
+}
+}
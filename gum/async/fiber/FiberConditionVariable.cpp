@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) Vladimir Golubev
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <gum/async/fiber/FiberConditionVariable.h>
+
+#include <gum/concurrency/ScopedCancellationCallback.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace gum {
+
+void FiberConditionVariable::wait(FiberMutex& mutex, ICancellationHandle& handle) {
+    Fiber* const self = Fiber::get_current();
+    GUM_CHECK(self, LogicError("FiberConditionVariable waited on outside of a fiber"));
+
+    FiberWaiter waiter(*self);
+    {
+        MutexLock l(_mutex);
+        _waiters.push_back(&waiter);
+    }
+
+    {
+        const auto waker = [&] {
+            if (waiter.claim()) {
+                remove(waiter);
+                self->unpark();
+            }
+        };
+        const ScopedCancellationCallback<decltype(waker)> callback(handle, waker);
+        if (!callback)
+            waker();
+
+        mutex.unlock();
+        Fiber::park();
+    }
+
+    mutex.lock();
+}
+
+void FiberConditionVariable::signal() {
+    FiberWaiter* woken = nullptr;
+    {
+        MutexLock l(_mutex);
+        while (!_waiters.empty() && !woken) {
+            FiberWaiter* const waiter = _waiters.front();
+            _waiters.pop_front();
+            if (waiter->claim())
+                woken = waiter;
+        }
+    }
+
+    if (woken)
+        woken->WaitingFiber.unpark();
+}
+
+void FiberConditionVariable::broadcast() {
+    std::vector<Fiber*> woken;
+    {
+        MutexLock l(_mutex);
+        for (FiberWaiter* waiter : _waiters)
+            if (waiter->claim())
+                woken.push_back(&waiter->WaitingFiber);
+        _waiters.clear();
+    }
+
+    for (Fiber* fiber : woken)
+        fiber->unpark();
+}
+
+void FiberConditionVariable::remove(FiberWaiter& waiter) {
+    MutexLock l(_mutex);
+
+    auto const iter = std::find(_waiters.begin(), _waiters.end(), &waiter);
+    if (iter != _waiters.end())
+        _waiters.erase(iter);
+}
+}
@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) Vladimir Golubev
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <gum/async/fiber/FiberMutex.h>
+
+#include <deque>
+
+namespace gum {
+
+class FiberConditionVariable {
+    Mutex _mutex;
+    std::deque<FiberWaiter*> _waiters;
+
+  public:
+    FiberConditionVariable() = default;
+
+    FiberConditionVariable(FiberConditionVariable const&) = delete;
+    FiberConditionVariable& operator=(FiberConditionVariable const&) = delete;
+
+    void wait(FiberMutex& mutex, ICancellationHandle& handle);
+
+    template <typename Predicate_>
+    void wait(FiberMutex& mutex, Predicate_ const& predicate, ICancellationHandle& handle) {
+        while (handle && !predicate())
+            wait(mutex, handle);
+    }
+
+    void signal();
+    void broadcast();
+
+  private:
+    void remove(FiberWaiter& waiter);
+};
+}
@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) Vladimir Golubev
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <gum/async/fiber/FiberMutex.h>
+
+namespace gum {
+
+FiberMutex::FiberMutex()
+    : _locked(false) {}
+
+void FiberMutex::lock() {
+    Fiber* const self = Fiber::get_current();
+    GUM_CHECK(self, LogicError("FiberMutex locked outside of a fiber"));
+
+    {
+        MutexLock l(_mutex);
+        if (!_locked) {
+            _locked = true;
+            return;
+        }
+        _waiters.push_back(self);
+    }
+
+    Fiber::park();
+}
+
+bool FiberMutex::try_lock() {
+    MutexLock l(_mutex);
+    if (_locked)
+        return false;
+
+    _locked = true;
+    return true;
+}
+
+void FiberMutex::unlock() {
+    Fiber* next = nullptr;
+    {
+        MutexLock l(_mutex);
+        GUM_CHECK(_locked, LogicError("FiberMutex unlocked while not locked"));
+
+        if (_waiters.empty()) {
+            _locked = false;
+            return;
+        }
+
+        next = _waiters.front();
+        _waiters.pop_front();
+    }
+
+    next->unpark();
+}
+}
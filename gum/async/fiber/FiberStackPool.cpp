@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) Vladimir Golubev
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <gum/async/fiber/FiberStackPool.h>
+
+#include <gum/sys/SystemException.h>
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace gum {
+
+namespace {
+
+size_t get_page_size() {
+    static const size_t page_size = sysconf(_SC_PAGESIZE);
+    return page_size;
+}
+}
+
+FiberStackPool::FiberStackPool(size_t stack_size, size_t max_cached)
+    : _stack_size((stack_size + get_page_size() - 1) / get_page_size() * get_page_size())
+    , _max_cached(max_cached) {
+    GUM_CHECK(_stack_size, ArgumentException("stack_size", stack_size));
+}
+
+FiberStackPool::~FiberStackPool() {
+    for (void* stack : _stacks)
+        munmap(stack, get_mapping_size());
+}
+
+boost::context::stack_context FiberStackPool::allocate() {
+    void* base = nullptr;
+    {
+        MutexLock l(_mutex);
+        if (!_stacks.empty()) {
+            base = _stacks.back();
+            _stacks.pop_back();
+        }
+    }
+
+    if (!base) {
+        base = mmap(nullptr, get_mapping_size(), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+        GUM_CHECK(base != MAP_FAILED, SystemException("mmap() failed for fiber stack"));
+
+        if (mprotect(base, get_page_size(), PROT_NONE) != 0) {
+            munmap(base, get_mapping_size());
+            GUM_THROW(SystemException("mprotect() failed for fiber stack guard page"));
+        }
+    }
+
+    boost::context::stack_context stack;
+    stack.size = _stack_size;
+    stack.sp = static_cast<char*>(base) + get_mapping_size();
+    return stack;
+}
+
+void FiberStackPool::deallocate(boost::context::stack_context& stack) {
+    void* const base = static_cast<char*>(stack.sp) - get_mapping_size();
+    {
+        MutexLock l(_mutex);
+        if (_stacks.size() < _max_cached) {
+            _stacks.push_back(base);
+            return;
+        }
+    }
+
+    munmap(base, get_mapping_size());
+}
+
+size_t FiberStackPool::get_stack_size() const {
+    return _stack_size;
+}
+
+size_t FiberStackPool::get_cached_count() const {
+    MutexLock l(_mutex);
+    return _stacks.size();
+}
+
+size_t FiberStackPool::get_mapping_size() const {
+    return _stack_size + get_page_size();
+}
+}
@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) Vladimir Golubev
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <gum/concurrency/Mutex.h>
+#include <gum/smartpointer/SharedReference.h>
+
+#include <boost/context/stack_context.hpp>
+
+#include <vector>
+
+namespace gum {
+
+class FiberStackPool {
+    using Stacks = std::vector<void*>;
+
+  private:
+    size_t _stack_size;
+    size_t _max_cached;
+
+    Mutex _mutex;
+    Stacks _stacks;
+
+  public:
+    FiberStackPool(size_t stack_size, size_t max_cached);
+    ~FiberStackPool();
+
+    FiberStackPool(FiberStackPool const&) = delete;
+    FiberStackPool& operator=(FiberStackPool const&) = delete;
+
+    boost::context::stack_context allocate();
+    void deallocate(boost::context::stack_context& stack);
+
+    size_t get_stack_size() const;
+    size_t get_cached_count() const;
+
+  private:
+    size_t get_mapping_size() const;
+};
+GUM_DECLARE_REF(FiberStackPool);
+
+class PooledFiberStackAllocator {
+    FiberStackPoolRef _pool;
+
+  public:
+    PooledFiberStackAllocator(FiberStackPoolRef const& pool)
+        : _pool(pool) {}
+
+    boost::context::stack_context allocate() {
+        return _pool->allocate();
+    }
+
+    void deallocate(boost::context::stack_context& stack) {
+        _pool->deallocate(stack);
+    }
+};
+}
@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) Vladimir Golubev
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <gum/async/coroutine/Awaitables.h>
+#include <gum/backend/boost/BoostSystemException.h>
+#include <gum/concurrency/DummyCancellationHandle.h>
+#include <gum/time/Types.h>
+
+#include <atomic>
+
+#include <boost/asio.hpp>
+#include <boost/asio/steady_timer.hpp>
+
+namespace gum {
+namespace asio {
+
+class SleepAwaiter {
+    struct State {
+        boost::asio::io_service& Service;
+        boost::asio::steady_timer Timer;
+        std::coroutine_handle<> Coroutine;
+        detail::AwaitGate Gate;
+        boost::system::error_code Error;
+        std::atomic<bool> CancelPosted;
+
+        State(boost::asio::io_service& service)
+            : Service(service)
+            , Timer(service)
+            , CancelPosted(false) {}
+
+        void cancel(SharedReference<State> const& self) {
+            if (!CancelPosted.exchange(true))
+                Service.post([self] { self->Timer.cancel(); });
+        }
+    };
+    GUM_DECLARE_REF(State);
+
+  private:
+    StateRef _state;
+    Duration _duration;
+    ICancellationHandle& _handle;
+    Token _token;
+
+  public:
+    SleepAwaiter(boost::asio::io_service& service, Duration const& duration, ICancellationHandle& handle)
+        : _state(make_shared_ref<State>(service))
+        , _duration(duration)
+        , _handle(handle) {}
+
+    bool await_ready() const noexcept {
+        return !_handle || _duration <= Duration::zero();
+    }
+
+    bool await_suspend(std::coroutine_handle<> coroutine) {
+        _state->Coroutine = coroutine;
+
+        _state->Timer.expires_from_now(_duration);
+        _state->Timer.async_wait([state = _state](boost::system::error_code const& error) {
+            state->Error = error;
+            if (state->Gate.complete())
+                state->Coroutine.resume();
+        });
+
+        _token = _handle.on_cancelled([state = _state] { state->cancel(state); });
+        if (!_handle)
+            _state->cancel(_state);
+
+        return _state->Gate.suspend();
+    }
+
+    void await_resume() const {
+        GUM_CHECK(!_state->Error || _state->Error == boost::asio::error::operation_aborted, BoostSystemException(_state->Error));
+    }
+};
+
+inline SleepAwaiter async_sleep(boost::asio::io_service& service, Duration const& duration, ICancellationHandle& handle = *DummyCancellationHandle()) {
+    return SleepAwaiter(service, duration, handle);
+}
+}
+}
@@ -38,6 +38,15 @@ BoostIoWorker::BoostIoWorker(const String& name, size_t concurrency_hint)
         _thread_pool.emplace_back(String() << name << ":" << i, [this](auto& handle) { thread_func(handle); });
 }
 
+BoostIoWorker::BoostIoWorker(const String& name, std::vector<ThreadPlacement> const& placements)
+    : _service(make_shared_ref<Service>(placements.size())) {
+    GUM_CHECK(!placements.empty(), ArgumentException("placements", "empty"));
+
+    _thread_pool.reserve(placements.size());
+    for (auto i : range(placements.size()))
+        _thread_pool.emplace_back(String() << name << ":" << i, placements[i], [this](auto& handle) { thread_func(handle); });
+}
+
 void BoostIoWorker::thread_func(ICancellationHandle& handle) {
     const auto token = handle.on_cancelled([this] { _service->stop(); });
     if (!handle)
@@ -41,6 +41,7 @@ class BoostIoWorker {
 
   public:
     BoostIoWorker(const String& name, size_t concurrency);
+    BoostIoWorker(const String& name, std::vector<ThreadPlacement> const& placements);
 
     ServiceRef get_service() {
         return _service;
@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) Vladimir Golubev
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <gum/Optional.h>
+#include <gum/Types.h>
+#include <gum/time/Types.h>
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+
+namespace gum {
+namespace dummy {
+
+class Futex {
+    struct Bucket {
+        std::mutex mutex;
+        std::condition_variable condition;
+    };
+
+    static constexpr size_t BucketCount = 64;
+
+  public:
+    using Word = std::atomic<u32>;
+
+  public:
+    static bool wait(Word& word, u32 expected, Optional<Duration> const& timeout) {
+        Bucket& bucket = get_bucket(word);
+        std::unique_lock<std::mutex> l(bucket.mutex);
+
+        if (word.load() != expected)
+            return true;
+
+        if (!timeout) {
+            bucket.condition.wait(l);
+            return true;
+        }
+        return bucket.condition.wait_for(l, *timeout) == std::cv_status::no_timeout;
+    }
+
+    static void wake(Word& word, int) {
+        Bucket& bucket = get_bucket(word);
+        { std::lock_guard<std::mutex> l(bucket.mutex); }
+        bucket.condition.notify_all();
+    }
+
+  private:
+    static Bucket& get_bucket(Word const& word) {
+        static std::array<Bucket, BucketCount> buckets;
+        return buckets[(reinterpret_cast<uintptr_t>(&word) / sizeof(Word)) % BucketCount];
+    }
+};
+}
+}
@@ -22,6 +22,8 @@
 
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <string>
 
 namespace gum {
@@ -32,5 +34,11 @@ struct BacktraceGetter {
         return "<unavailable>";
     }
 };
+
+struct RawBacktraceGetter {
+    size_t operator()(uintptr_t*, size_t) const {
+        return 0;
+    }
+};
 }
 }
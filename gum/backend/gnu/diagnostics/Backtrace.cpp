@@ -22,6 +22,7 @@
 
 #include <gum/backend/gnu/diagnostics/Backtrace.h>
 
+#include <algorithm>
 #include <array>
 #include <sstream>
 
@@ -85,5 +86,13 @@ std::string BacktraceGetter::operator()() const {
 
     return ss.str();
 }
+
+size_t RawBacktraceGetter::operator()(uintptr_t* frames, size_t capacity) const {
+    BacktraceHolder backtrace;
+
+    const size_t size = std::min(capacity, backtrace.get_size());
+    std::copy_n(backtrace.get_array().begin(), size, frames);
+    return size;
+}
 }
 }
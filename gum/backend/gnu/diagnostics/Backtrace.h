@@ -22,6 +22,8 @@
 
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <string>
 
 namespace gum {
@@ -30,5 +32,9 @@ namespace gnu {
 struct BacktraceGetter {
     std::string operator()() const;
 };
+
+struct RawBacktraceGetter {
+    size_t operator()(uintptr_t* frames, size_t capacity) const;
+};
 }
 }
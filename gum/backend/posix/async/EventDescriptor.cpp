@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) Vladimir Golubev
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <gum/backend/posix/async/EventDescriptor.h>
+
+#include <gum/sys/SystemException.h>
+#include <gum/token/FunctionToken.h>
+
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+namespace gum {
+namespace posix {
+
+EventDescriptor::EventDescriptor()
+    : _fd(eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)) {
+    GUM_CHECK(_fd >= 0, SystemException("eventfd() failed"));
+
+    _closeToken = make_token<FunctionToken>([fd = _fd]() { close(fd); });
+}
+
+void EventDescriptor::set() {
+    const eventfd_t value = 1;
+    while (write(_fd, &value, sizeof(value)) < 0 && errno == EINTR)
+        ;
+}
+
+void EventDescriptor::reset() {
+    eventfd_t value;
+    while (read(_fd, &value, sizeof(value)) < 0 && errno == EINTR)
+        ;
+}
+}
+}
@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) Vladimir Golubev
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <gum/backend/posix/concurrency/Futex.h>
+
+#include <gum/sys/SystemException.h>
+
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <cerrno>
+
+namespace gum {
+namespace posix {
+
+static_assert(sizeof(Futex::Word) == sizeof(u32), "Futex word must be a plain 32-bit integer");
+
+namespace {
+
+long futex(Futex::Word& word, int op, u32 value, timespec const* timeout) {
+    return syscall(SYS_futex, reinterpret_cast<u32*>(&word), op, value, timeout, nullptr, 0);
+}
+}
+
+bool Futex::wait(Word& word, u32 expected, Optional<Duration> const& timeout) {
+    timespec ts;
+    if (timeout) {
+        const auto ns = std::chrono::duration_cast<Nanoseconds>(std::max(*timeout, Duration::zero())).count();
+        ts.tv_sec = ns / 1000000000;
+        ts.tv_nsec = ns % 1000000000;
+    }
+
+    if (futex(word, FUTEX_WAIT_PRIVATE, expected, timeout ? &ts : nullptr) == 0)
+        return true;
+
+    GUM_CHECK(errno == EAGAIN || errno == EINTR || errno == ETIMEDOUT, SystemException("futex(FUTEX_WAIT) failed"));
+    return errno != ETIMEDOUT;
+}
+
+void Futex::wake(Word& word, int count) {
+    futex(word, FUTEX_WAKE_PRIVATE, count, nullptr);
+}
+}
+}
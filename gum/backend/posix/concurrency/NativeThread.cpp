@@ -0,0 +1,188 @@
+/*
+ * Copyright (c) Vladimir Golubev
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <gum/backend/posix/concurrency/NativeThread.h>
+
+#include <gum/sys/SystemException.h>
+
+#include <pthread.h>
+#include <signal.h>
+#include <time.h>
+#include <ucontext.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <mutex>
+
+namespace gum {
+namespace posix {
+
+namespace {
+
+// A real-time signal, far from the low ones that libraries tend to claim; interrupts are tagged so the
+// handler can tell them apart from signals meant for a previously installed handler
+int get_interrupt_signal() {
+    return SIGRTMAX - 3;
+}
+
+struct sigaction g_previous_action;
+
+std::atomic<NativeThread::InterruptHandler>& get_interrupt_handler() {
+    static std::atomic<NativeThread::InterruptHandler> handler(nullptr);
+    return handler;
+}
+
+void* get_interrupt_tag() {
+    return &get_interrupt_handler();
+}
+
+void chain_interrupt_signal(int signal, siginfo_t* info, void* context) {
+    if (g_previous_action.sa_flags & SA_SIGINFO) {
+        if (g_previous_action.sa_sigaction)
+            g_previous_action.sa_sigaction(signal, info, context);
+    } else if (g_previous_action.sa_handler != SIG_DFL && g_previous_action.sa_handler != SIG_IGN)
+        g_previous_action.sa_handler(signal);
+}
+
+void handle_interrupt_signal(int signal, siginfo_t* info, void* context) {
+    const int saved_errno = errno;
+    if (info->si_code == SI_QUEUE && info->si_value.sival_ptr == get_interrupt_tag()) {
+        if (const NativeThread::InterruptHandler handler = get_interrupt_handler().load(std::memory_order_acquire))
+            handler(context);
+    } else
+        chain_interrupt_signal(signal, info, context);
+    errno = saved_errno;
+}
+
+#if defined(__x86_64__)
+bool get_interrupted_registers(void* context, uintptr_t& pc, uintptr_t& fp, uintptr_t& sp) {
+    mcontext_t const& mcontext = static_cast<ucontext_t const*>(context)->uc_mcontext;
+    pc = mcontext.gregs[REG_RIP];
+    fp = mcontext.gregs[REG_RBP];
+    sp = mcontext.gregs[REG_RSP];
+    return true;
+}
+#elif defined(__aarch64__)
+bool get_interrupted_registers(void* context, uintptr_t& pc, uintptr_t& fp, uintptr_t& sp) {
+    mcontext_t const& mcontext = static_cast<ucontext_t const*>(context)->uc_mcontext;
+    pc = mcontext.pc;
+    fp = mcontext.regs[29];
+    sp = mcontext.sp;
+    return true;
+}
+#else
+bool get_interrupted_registers(void*, uintptr_t&, uintptr_t&, uintptr_t&) {
+    return false;
+}
+#endif
+
+Optional<Duration> get_clock_time(clockid_t clock) {
+    timespec ts;
+    if (clock_gettime(clock, &ts) != 0)
+        return nullptr;
+    return std::chrono::duration_cast<Duration>(Seconds(ts.tv_sec) + Nanoseconds(ts.tv_nsec));
+}
+}
+
+NativeThread::Handle NativeThread::get_current() {
+    return pthread_self();
+}
+
+Optional<Duration> NativeThread::get_own_cpu_time() {
+    return get_clock_time(CLOCK_THREAD_CPUTIME_ID);
+}
+
+Optional<Duration> NativeThread::get_cpu_time(Handle thread) {
+    clockid_t clock;
+    if (pthread_getcpuclockid(thread, &clock) != 0)
+        return nullptr;
+    return get_clock_time(clock);
+}
+
+NativeThread::StackBounds NativeThread::get_own_stack_bounds() {
+    StackBounds bounds;
+
+    pthread_attr_t attr;
+    if (pthread_getattr_np(pthread_self(), &attr) != 0)
+        return bounds;
+
+    void* address = nullptr;
+    size_t size = 0;
+    if (pthread_attr_getstack(&attr, &address, &size) == 0) {
+        bounds.Low = reinterpret_cast<uintptr_t>(address);
+        bounds.High = bounds.Low + size;
+    }
+
+    pthread_attr_destroy(&attr);
+    return bounds;
+}
+
+size_t NativeThread::get_interrupted_frames(void* context, StackBounds const& stack, uintptr_t* frames, size_t capacity) {
+    uintptr_t pc, fp, sp;
+    if (!capacity || !get_interrupted_registers(context, pc, fp, sp))
+        return 0;
+
+    size_t size = 0;
+    frames[size++] = pc;
+
+    // Every frame record is checked to lie on the live part of the stack, so a bogus chain stops the walk instead of faulting
+    const uintptr_t low = std::max(sp, stack.Low);
+    while (size < capacity && fp >= low && fp % alignof(uintptr_t) == 0 && fp + 2 * sizeof(uintptr_t) <= stack.High) {
+        uintptr_t const* const record = reinterpret_cast<uintptr_t const*>(fp);
+        const uintptr_t next_fp = record[0];
+        const uintptr_t return_address = record[1];
+
+        if (!return_address)
+            break;
+        frames[size++] = return_address;
+
+        if (next_fp <= fp)
+            break;
+        fp = next_fp;
+    }
+    return size;
+}
+
+void NativeThread::set_interrupt_handler(InterruptHandler handler) {
+    static std::once_flag installed;
+    std::call_once(installed, [] {
+        struct sigaction action = {};
+        action.sa_sigaction = &handle_interrupt_signal;
+        action.sa_flags = SA_SIGINFO | SA_RESTART;
+        sigemptyset(&action.sa_mask);
+        GUM_CHECK(sigaction(get_interrupt_signal(), &action, &g_previous_action) == 0, SystemException("sigaction() failed for thread interrupt signal"));
+    });
+
+    get_interrupt_handler().store(handler, std::memory_order_release);
+}
+
+bool NativeThread::interrupt(Handle thread) {
+    if (!get_interrupt_handler().load(std::memory_order_acquire))
+        return false;
+
+    sigval value;
+    value.sival_ptr = get_interrupt_tag();
+    return pthread_sigqueue(thread, get_interrupt_signal(), value) == 0;
+}
+}
+}
@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) Vladimir Golubev
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <gum/Optional.h>
+#include <gum/time/Types.h>
+
+#include <cstdint>
+#include <thread>
+
+namespace gum {
+namespace posix {
+
+struct NativeThread {
+    using Handle = std::thread::native_handle_type;
+
+    // Runs in a signal handler on the interrupted thread and gets its ucontext_t, so it must be async-signal-safe
+    using InterruptHandler = void (*)(void* context);
+
+    struct StackBounds {
+        uintptr_t Low = 0;
+        uintptr_t High = 0;
+    };
+
+  public:
+    static Handle get_current();
+
+    static Optional<Duration> get_own_cpu_time();
+    static Optional<Duration> get_cpu_time(Handle thread);
+
+    static StackBounds get_own_stack_bounds();
+
+    // Async-signal-safe; frames past the interrupted instruction are only found through frame pointers, so gum is built with -fno-omit-frame-pointer
+    static size_t get_interrupted_frames(void* context, StackBounds const& stack, uintptr_t* frames, size_t capacity);
+
+    // Installs the signal handler on the first call, chaining to the previous disposition for foreign signals
+    static void set_interrupt_handler(InterruptHandler handler);
+    static bool interrupt(Handle thread);
+};
+}
+}
@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) Vladimir Golubev
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <gum/backend/posix/concurrency/ThreadPlacement.h>
+
+#include <gum/string/ToString.h>
+#include <gum/sys/SystemException.h>
+
+#include <linux/mempolicy.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <climits>
+#include <vector>
+
+namespace gum {
+namespace posix {
+
+void ThreadPlacement::set_cpus(CpuSet const& cpus) {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (u32 cpu : cpus) {
+        GUM_CHECK(cpu < CPU_SETSIZE, ArgumentException("cpu", cpu));
+        CPU_SET(cpu, &set);
+    }
+
+    GUM_CHECK(sched_setaffinity(0, sizeof(set), &set) == 0, SystemException(String() << "sched_setaffinity(" << cpus << ") failed"));
+}
+
+void ThreadPlacement::set_memory_node(u32 node) {
+    constexpr size_t BitsPerWord = sizeof(unsigned long) * CHAR_BIT;
+
+    std::vector<unsigned long> mask(node / BitsPerWord + 1);
+    mask[node / BitsPerWord] |= 1ul << (node % BitsPerWord);
+
+    GUM_CHECK(syscall(SYS_set_mempolicy, MPOL_PREFERRED, mask.data(), mask.size() * BitsPerWord + 1) == 0,
+        SystemException(String() << "set_mempolicy(" << node << ") failed"));
+}
+}
+}
@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) Vladimir Golubev
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <gum/concurrency/FutexWaitable.h>
+
+namespace gum {
+
+class Barrier : private detail::FutexWaitable {
+    static constexpr u32 PhaseUnit = 1u << 16;
+    static constexpr u32 RemainingMask = PhaseUnit - 1;
+    static constexpr u32 PhaseMask = PayloadMask & ~RemainingMask;
+
+  private:
+    const u32 _expected;
+
+  public:
+    explicit Barrier(u32 expected)
+        : FutexWaitable(expected)
+        , _expected(expected) {
+        GUM_CHECK(expected && expected <= RemainingMask, ArgumentException("expected", expected));
+    }
+
+    bool arrive_and_wait(ICancellationHandle& handle) {
+        const u32 state = _state.fetch_sub(1, std::memory_order_acq_rel);
+        if ((state & RemainingMask) == 1) {
+            _state.fetch_add(_expected + PhaseUnit, std::memory_order_release);
+            wake_all();
+            return true;
+        }
+
+        const u32 phase = state & PhaseMask;
+        return wait_until([phase](u32 state) { return (state & PhaseMask) != phase; }, get_infinite_deadline(), handle);
+    }
+};
+}
@@ -22,108 +22,236 @@
 
 #include <gum/concurrency/CancellationToken.h>
 
-#include <gum/Optional.h>
-#include <gum/concurrency/ConditionVariable.h>
-#include <gum/concurrency/DummyCancellationHandle.h>
-#include <gum/concurrency/Mutex.h>
+#include <gum/concurrency/CpuRelax.h>
+#include <gum/concurrency/Futex.h>
+#include <gum/smartpointer/UniquePtr.h>
 #include <gum/token/FunctionToken.h>
 
-#include <atomic>
+#include <thread>
 
 namespace gum {
 
 class CancellationToken::Impl {
     using CancellationHandler = ICancellationToken::CancellationHandler;
 
+  private:
+    static constexpr u32 CancelledFlag = 1;
+    static constexpr u32 LockedFlag = 2;
+    static constexpr size_t SpinsBeforeYield = 64;
+
+    class ParentLink : public CancellationCallback {
+        Impl& _child;
+
+      public:
+        ParentLink(Impl& child)
+            : _child(child) {}
+
+        void handle_cancellation() override {
+            _child.cancel();
+        }
+    };
+
   public:
-    Mutex _mutex;
-    ConditionVariable _cancel_condition;
-    Optional<CancellationHandler> _cancellation_handler;
-    std::atomic<bool> _is_cancelled;
-    bool _cancel_in_progress;
+    class HandlerRegistration : public CancellationCallback, public IToken {
+        ImplRef _impl;
+        CancellationHandler _handler;
+
+      public:
+        HandlerRegistration(ImplRef const& impl, CancellationHandler const& handler)
+            : _impl(impl)
+            , _handler(handler) {}
+
+        ~HandlerRegistration() {
+            _impl->remove(*this);
+        }
+
+        void handle_cancellation() override {
+            _handler();
+        }
+    };
+
+  private:
+    mutable Futex::Word _state;
+    CancellationCallback* _callbacks;
+    CancellationCallback* _running;
+    Futex::Word _running_generation;
+    bool _running_awaited;
+    std::thread::id _cancelling_thread;
+
+    ImplPtr _parent;
+    ParentLink _parent_link;
 
   public:
-    Impl()
-        : _is_cancelled(false)
-        , _cancel_in_progress(false) {}
+    Impl(ImplPtr const& parent = nullptr)
+        : _state(0)
+        , _callbacks(nullptr)
+        , _running(nullptr)
+        , _running_generation(0)
+        , _running_awaited(false)
+        , _parent(parent)
+        , _parent_link(*this) {
+        if (_parent && !_parent->add(_parent_link))
+            cancel();
+    }
+
+    ~Impl() {
+        if (_parent)
+            _parent->remove(_parent_link);
+    }
 
     bool is_cancelled() const {
-        return _is_cancelled;
+        return _state.load(std::memory_order_acquire) & CancelledFlag;
     }
 
     void sleep(Duration const& duration) const {
-        if (_is_cancelled)
-            return;
+        const auto deadline = SteadyClock::now() + duration;
 
-        MutexLock l(_mutex);
+        for (u32 state = _state.load(std::memory_order_acquire); !(state & CancelledFlag); state = _state.load(std::memory_order_acquire)) {
+            const auto now = SteadyClock::now();
+            if (now >= deadline)
+                return;
 
-        while (!_is_cancelled)
-            if (_cancel_condition.wait_for(_mutex, duration, *DummyCancellationHandle()) == ConditionVariable::WaitResult::TimedOut)
-                break;
+            Futex::wait_for(_state, state, std::chrono::duration_cast<Duration>(deadline - now));
+        }
     }
 
-    bool on_cancelled(CancellationHandler const& cancellation_handler) {
-        if (_is_cancelled)
+    bool add(CancellationCallback& callback) {
+        if (!lock_unless_cancelled())
             return false;
 
-        MutexLock l(_mutex);
+        callback._prev = nullptr;
+        callback._next = _callbacks;
+        if (_callbacks)
+            _callbacks->_prev = &callback;
+        _callbacks = &callback;
 
-        if (_is_cancelled)
-            return false;
-
-        GUM_CHECK(!_cancellation_handler, "Cancellation handler already registered");
-        _cancellation_handler = cancellation_handler;
+        unlock();
         return true;
     }
 
-    void unregister_cancellation_handler() {
-        MutexLock l(_mutex);
+    void remove(CancellationCallback& callback) {
+        lock();
 
-        _cancellation_handler.reset();
+        if (callback._prev || _callbacks == &callback) {
+            unlink(callback);
+            unlock();
+            return;
+        }
+
+        if (_running != &callback) {
+            unlock();
+            return;
+        }
 
-        while (_cancel_in_progress)
-            _cancel_condition.wait(_mutex, *DummyCancellationHandle());
+        if (_cancelling_thread == std::this_thread::get_id()) {
+            *callback._removed_while_running = true;
+            unlock();
+            return;
+        }
+
+        _running_awaited = true;
+        const u32 generation = _running_generation.load(std::memory_order_relaxed);
+        unlock();
+
+        while (_running_generation.load(std::memory_order_acquire) == generation)
+            Futex::wait(_running_generation, generation);
     }
 
     void cancel() {
-        if (_is_cancelled)
+        if (!lock_unless_cancelled())
             return;
 
-        Optional<CancellationHandler> cancellation_handler;
-        {
-            MutexLock l(_mutex);
+        _state.fetch_or(CancelledFlag, std::memory_order_relaxed);
+        _cancelling_thread = std::this_thread::get_id();
+
+        while (CancellationCallback* const callback = _callbacks) {
+            unlink(*callback);
+            _running = callback;
+            unlock();
+
+            bool removed_while_running = false;
+            callback->_removed_while_running = &removed_while_running;
+            callback->handle_cancellation();
+
+            if (!removed_while_running)
+                callback->_removed_while_running = nullptr;
+
+            lock();
+            _running = nullptr;
+            _running_generation.fetch_add(1, std::memory_order_release);
+            if (_running_awaited) {
+                _running_awaited = false;
+                unlock();
+                Futex::wake_all(_running_generation);
+                lock();
+            }
+        }
 
-            if (_is_cancelled)
-                return;
+        _running = nullptr;
+        unlock();
 
-            _is_cancelled = true;
+        Futex::wake_all(_state);
+    }
 
-            _cancel_in_progress = true;
-            _cancellation_handler.swap(cancellation_handler);
-        }
+    void reset() {
+        lock();
+        const bool in_use = _running != nullptr;
+        if (!in_use)
+            _state.fetch_and(~CancelledFlag, std::memory_order_relaxed);
+        unlock();
 
-        if (cancellation_handler)
-            (*cancellation_handler)();
+        GUM_CHECK(!in_use, "reset() called while cancellation token is being used");
+    }
 
-        {
-            MutexLock l(_mutex);
+  private:
+    void unlink(CancellationCallback& callback) {
+        if (callback._prev)
+            callback._prev->_next = callback._next;
+        else
+            _callbacks = callback._next;
 
-            _cancel_in_progress = false;
-            _cancel_condition.broadcast();
-        }
+        if (callback._next)
+            callback._next->_prev = callback._prev;
+
+        callback._prev = callback._next = nullptr;
     }
 
-    void reset() {
-        MutexLock l(_mutex);
+    void lock() const {
+        lock_if([](u32) { return true; });
+    }
+
+    bool lock_unless_cancelled() const {
+        return lock_if([](u32 state) { return !(state & CancelledFlag); });
+    }
+
+    template <typename Predicate_>
+    bool lock_if(Predicate_ const& predicate) const {
+        for (size_t spins = 0;; ++spins) {
+            u32 state = _state.load(std::memory_order_relaxed);
+            if (!predicate(state))
+                return false;
 
-        GUM_CHECK(!_cancellation_handler && !_cancel_in_progress, "reset() called while cancellation token is being used");
-        _is_cancelled = false;
+            if (!(state & LockedFlag) && _state.compare_exchange_weak(state, state | LockedFlag, std::memory_order_acquire, std::memory_order_relaxed))
+                return true;
+
+            if (spins < SpinsBeforeYield)
+                cpu_relax();
+            else
+                std::this_thread::yield();
+        }
+    }
+
+    void unlock() const {
+        _state.fetch_and(~LockedFlag, std::memory_order_release);
     }
 };
 
 CancellationToken::CancellationToken()
     : _impl(make_shared_ref<Impl>()) {}
 
+CancellationToken::CancellationToken(ImplRef const& impl)
+    : _impl(impl) {}
+
 CancellationToken::operator bool() const {
     return !_impl->is_cancelled();
 }
@@ -133,9 +261,18 @@ void CancellationToken::sleep(Duration const& duration) const {
 }
 
 Token CancellationToken::on_cancelled(CancellationHandler const& cancellation_handler) {
-    if (_impl->on_cancelled(cancellation_handler))
-        return make_token<FunctionToken>([impl = _impl] { impl->unregister_cancellation_handler(); });
-    return Token();
+    auto registration = gum::make_unique<Impl::HandlerRegistration>(_impl, cancellation_handler);
+    if (!_impl->add(*registration))
+        return Token();
+    return Token(std::move(registration));
+}
+
+bool CancellationToken::register_callback(CancellationCallback& callback) {
+    return _impl->add(callback);
+}
+
+void CancellationToken::unregister_callback(CancellationCallback& callback) {
+    _impl->remove(callback);
 }
 
 void CancellationToken::cancel() {
@@ -149,4 +286,8 @@ void CancellationToken::reset() {
 Token CancellationToken::get_cancellator() const {
     return make_token<FunctionToken>([impl = _impl] { impl->cancel(); });
 }
+
+CancellationToken CancellationToken::create_child() const {
+    return CancellationToken(make_shared_ref<Impl>(_impl));
+}
 }
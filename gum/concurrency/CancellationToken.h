@@ -23,17 +23,22 @@
 #pragma once
 
 #include <gum/concurrency/ICancellationToken.h>
+#include <gum/smartpointer/SharedPtr.h>
 #include <gum/smartpointer/SharedReference.h>
 
 namespace gum {
 
 class CancellationToken : public virtual ICancellationToken {
     class Impl;
+    GUM_DECLARE_PTR(Impl);
     GUM_DECLARE_REF(Impl);
 
   private:
     ImplRef _impl;
 
+  private:
+    CancellationToken(ImplRef const& impl);
+
   public:
     CancellationToken();
 
@@ -48,9 +53,14 @@ class CancellationToken : public virtual ICancellationToken {
 
     Token on_cancelled(CancellationHandler const& cancellation_handler) override;
 
+    bool register_callback(CancellationCallback& callback) override;
+    void unregister_callback(CancellationCallback& callback) override;
+
     void cancel() override;
     void reset() override;
 
     Token get_cancellator() const override;
+
+    CancellationToken create_child() const;
 };
 }
@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) Vladimir Golubev
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <gum/concurrency/Channel.h>
+
+#include <algorithm>
+
+namespace gum {
+namespace detail {
+
+namespace {
+
+thread_local size_t t_select_rotation = 0;
+
+class SelectObservation {
+    IChannelSelectCase* const* _cases;
+    size_t _count;
+    Futex::Word& _epoch;
+    bool _attached;
+
+  public:
+    SelectObservation(IChannelSelectCase* const* cases, size_t count, Futex::Word& epoch)
+        : _cases(cases)
+        , _count(count)
+        , _epoch(epoch)
+        , _attached(false) {}
+
+    ~SelectObservation() {
+        if (_attached)
+            for (size_t i = 0; i < _count; ++i)
+                _cases[i]->get_event().detach(_epoch);
+    }
+
+    SelectObservation(SelectObservation const&) = delete;
+    SelectObservation& operator=(SelectObservation const&) = delete;
+
+    bool attach() {
+        if (_attached)
+            return false;
+
+        for (size_t i = 0; i < _count; ++i)
+            _cases[i]->get_event().attach(_epoch);
+        _attached = true;
+        return true;
+    }
+};
+}
+
+void ChannelEvent::attach(Futex::Word& observer) {
+    MutexLock l(_mutex);
+    _observers.push_back(&observer);
+    _observers_count.fetch_add(1);
+}
+
+void ChannelEvent::detach(Futex::Word& observer) {
+    MutexLock l(_mutex);
+    const auto it = std::find(_observers.begin(), _observers.end(), &observer);
+    if (it == _observers.end())
+        return;
+
+    _observers.erase(it);
+    _observers_count.fetch_sub(1, std::memory_order_relaxed);
+}
+
+void ChannelEvent::notify_observers() {
+    MutexLock l(_mutex);
+    for (Futex::Word* const observer : _observers) {
+        observer->fetch_add(1, std::memory_order_release);
+        Futex::wake_all(*observer);
+    }
+}
+
+Optional<size_t> select(IChannelSelectCase* const* cases, size_t count, ICancellationHandle& handle) {
+    Futex::Word epoch(0);
+    const auto waker = [&epoch] {
+        epoch.fetch_add(1, std::memory_order_release);
+        Futex::wake_all(epoch);
+    };
+    const ScopedCancellationCallback<decltype(waker)> callback(handle, waker);
+    SelectObservation observation(cases, count, epoch);
+
+    const size_t start = t_select_rotation++;
+    for (;;) {
+        const u32 seen = epoch.load(std::memory_order_acquire);
+
+        bool finished = true;
+        for (size_t i = 0; i < count; ++i) {
+            const size_t index = (start + i) % count;
+            const bool case_finished = cases[index]->is_finished();
+            if (cases[index]->try_fire())
+                return index;
+            finished = finished && case_finished;
+        }
+
+        if (finished || !handle)
+            return nullptr;
+
+        if (!observation.attach())
+            Futex::wait(epoch, seen);
+    }
+}
+}
+}
@@ -0,0 +1,563 @@
+/*
+ * Copyright (c) Vladimir Golubev
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <gum/Optional.h>
+#include <gum/concurrency/CacheLine.h>
+#include <gum/concurrency/FutexWaitable.h>
+#include <gum/concurrency/Mutex.h>
+
+#include <atomic>
+#include <type_traits>
+#include <vector>
+
+namespace gum {
+
+enum class ChannelKind { Spsc, Mpmc };
+
+template <typename Value_, ChannelKind Kind_>
+class Channel;
+
+namespace detail {
+
+template <typename Value_, ChannelKind Kind_, typename Handler_>
+class ChannelReceiveCase;
+
+template <typename Value_, ChannelKind Kind_, typename Handler_>
+class ChannelSendCase;
+
+// The closed flag lives in the producer's position word, so a push either lands before close() or fails.
+constexpr size_t ChannelClosedBit = ~(~size_t(0) >> 1);
+
+// The sequence scheme of MpmcRing needs at least two cells, so capacity 1 is rounded up to 2 as well.
+inline size_t get_channel_ring_size(size_t capacity) {
+    GUM_CHECK(capacity, ArgumentException("capacity", capacity));
+
+    size_t size = 2;
+    while (size < capacity)
+        size <<= 1;
+    return size;
+}
+
+template <typename Value_>
+class ChannelSlot {
+    typename std::aligned_storage<sizeof(Value_), alignof(Value_)>::type _storage;
+
+  public:
+    Value_& get() {
+        return *reinterpret_cast<Value_*>(&_storage);
+    }
+
+    void construct(Value_&& value) {
+        new (&_storage) Value_(std::move(value));
+    }
+
+    template <typename Consumer_>
+    void consume(Consumer_&& consumer) {
+        consumer(std::move(get()));
+        get().~Value_();
+    }
+};
+
+template <typename Value_>
+class SpscRing {
+    struct alignas(CacheLineSize) Producer {
+        std::atomic<size_t> Tail{0};
+        size_t CachedHead = 0;
+    };
+
+    struct alignas(CacheLineSize) Consumer {
+        std::atomic<size_t> Head{0};
+        size_t CachedTail = 0;
+    };
+
+  private:
+    Producer _producer;
+    Consumer _consumer;
+    size_t _mask;
+    std::vector<ChannelSlot<Value_>> _slots;
+
+  public:
+    explicit SpscRing(size_t capacity)
+        : _mask(get_channel_ring_size(capacity) - 1)
+        , _slots(_mask + 1) {}
+
+    ~SpscRing() {
+        while (try_pop([](Value_&&) {}))
+            ;
+    }
+
+    size_t get_capacity() const {
+        return _slots.size();
+    }
+
+    bool try_push(Value_& value) {
+        size_t tail = _producer.Tail.load(std::memory_order_relaxed);
+        if (tail & ChannelClosedBit)
+            return false;
+
+        if (tail - _producer.CachedHead == _slots.size()) {
+            _producer.CachedHead = _consumer.Head.load(std::memory_order_acquire);
+            if (tail - _producer.CachedHead == _slots.size())
+                return false;
+        }
+
+        ChannelSlot<Value_>& slot = _slots[tail & _mask];
+        slot.construct(std::move(value));
+        if (_producer.Tail.compare_exchange_strong(tail, tail + 1, std::memory_order_release, std::memory_order_relaxed))
+            return true;
+
+        slot.consume([&](Value_&& pushed) { value = std::move(pushed); });
+        return false;
+    }
+
+    template <typename Iterator_>
+    Iterator_ try_push_batch(Iterator_ begin, Iterator_ end) {
+        size_t start = _producer.Tail.load(std::memory_order_relaxed);
+        if (start & ChannelClosedBit)
+            return begin;
+
+        _producer.CachedHead = _consumer.Head.load(std::memory_order_acquire);
+
+        const Iterator_ first = begin;
+        size_t tail = start;
+        for (; begin != end && tail - _producer.CachedHead != _slots.size(); ++begin, ++tail)
+            _slots[tail & _mask].construct(std::move(*begin));
+
+        if (tail == start || _producer.Tail.compare_exchange_strong(start, tail, std::memory_order_release, std::memory_order_relaxed))
+            return begin;
+
+        Iterator_ restored = first;
+        for (size_t pos = start; pos != tail; ++pos, ++restored)
+            _slots[pos & _mask].consume([&](Value_&& pushed) { *restored = std::move(pushed); });
+        return first;
+    }
+
+    template <typename Consumer_>
+    bool try_pop(Consumer_&& consumer) {
+        const size_t head = _consumer.Head.load(std::memory_order_relaxed);
+        if (head == _consumer.CachedTail) {
+            _consumer.CachedTail = _producer.Tail.load(std::memory_order_acquire) & ~ChannelClosedBit;
+            if (head == _consumer.CachedTail)
+                return false;
+        }
+
+        _slots[head & _mask].consume(consumer);
+        _consumer.Head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    template <typename Consumer_>
+    size_t try_pop_batch(size_t max, Consumer_&& consumer) {
+        const size_t start = _consumer.Head.load(std::memory_order_relaxed);
+        _consumer.CachedTail = _producer.Tail.load(std::memory_order_acquire) & ~ChannelClosedBit;
+
+        size_t head = start;
+        for (; head != _consumer.CachedTail && head - start != max; ++head)
+            _slots[head & _mask].consume(consumer);
+
+        if (head != start)
+            _consumer.Head.store(head, std::memory_order_release);
+        return head - start;
+    }
+
+    void close() {
+        _producer.Tail.fetch_or(ChannelClosedBit, std::memory_order_acq_rel);
+    }
+
+    bool is_closed() const {
+        return _producer.Tail.load(std::memory_order_acquire) & ChannelClosedBit;
+    }
+
+    bool is_drained() const {
+        const size_t tail = _producer.Tail.load(std::memory_order_acquire);
+        return (tail & ChannelClosedBit) && _consumer.Head.load(std::memory_order_acquire) == (tail & ~ChannelClosedBit);
+    }
+};
+
+template <typename Value_>
+class MpmcRing {
+    struct Cell {
+        std::atomic<size_t> Sequence;
+        ChannelSlot<Value_> Slot;
+    };
+
+  private:
+    alignas(CacheLineSize) std::atomic<size_t> _enqueue_pos;
+    alignas(CacheLineSize) std::atomic<size_t> _dequeue_pos;
+    alignas(CacheLineSize) size_t _mask;
+    std::vector<Cell> _cells;
+
+  public:
+    explicit MpmcRing(size_t capacity)
+        : _enqueue_pos(0)
+        , _dequeue_pos(0)
+        , _mask(get_channel_ring_size(capacity) - 1)
+        , _cells(_mask + 1) {
+        for (size_t i = 0; i < _cells.size(); ++i)
+            _cells[i].Sequence.store(i, std::memory_order_relaxed);
+    }
+
+    ~MpmcRing() {
+        while (try_pop([](Value_&&) {}))
+            ;
+    }
+
+    size_t get_capacity() const {
+        return _cells.size();
+    }
+
+    bool try_push(Value_& value) {
+        size_t pos = _enqueue_pos.load(std::memory_order_relaxed);
+        for (;;) {
+            if (pos & ChannelClosedBit)
+                return false;
+
+            Cell& cell = _cells[pos & _mask];
+            const std::ptrdiff_t diff = (std::ptrdiff_t)cell.Sequence.load(std::memory_order_acquire) - (std::ptrdiff_t)pos;
+
+            if (diff < 0)
+                return false;
+
+            if (diff > 0)
+                pos = _enqueue_pos.load(std::memory_order_relaxed);
+            else if (_enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                cell.Slot.construct(std::move(value));
+                cell.Sequence.store(pos + 1, std::memory_order_release);
+                return true;
+            }
+        }
+    }
+
+    template <typename Iterator_>
+    Iterator_ try_push_batch(Iterator_ begin, Iterator_ end) {
+        for (; begin != end && try_push(*begin); ++begin)
+            ;
+        return begin;
+    }
+
+    template <typename Consumer_>
+    bool try_pop(Consumer_&& consumer) {
+        size_t pos = _dequeue_pos.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = _cells[pos & _mask];
+            const std::ptrdiff_t diff = (std::ptrdiff_t)cell.Sequence.load(std::memory_order_acquire) - (std::ptrdiff_t)(pos + 1);
+
+            if (diff < 0)
+                return false;
+
+            if (diff > 0)
+                pos = _dequeue_pos.load(std::memory_order_relaxed);
+            else if (_dequeue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                cell.Slot.consume(consumer);
+                cell.Sequence.store(pos + _mask + 1, std::memory_order_release);
+                return true;
+            }
+        }
+    }
+
+    template <typename Consumer_>
+    size_t try_pop_batch(size_t max, Consumer_&& consumer) {
+        size_t count = 0;
+        for (; count != max && try_pop(consumer); ++count)
+            ;
+        return count;
+    }
+
+    void close() {
+        _enqueue_pos.fetch_or(ChannelClosedBit, std::memory_order_acq_rel);
+    }
+
+    bool is_closed() const {
+        return _enqueue_pos.load(std::memory_order_acquire) & ChannelClosedBit;
+    }
+
+    // Pushes that won their slot before close() are still being published until the dequeue position catches up
+    bool is_drained() const {
+        const size_t pos = _enqueue_pos.load(std::memory_order_acquire);
+        return (pos & ChannelClosedBit) && _dequeue_pos.load(std::memory_order_acquire) == (pos & ~ChannelClosedBit);
+    }
+};
+
+template <typename Value_, ChannelKind Kind_>
+struct ChannelRing {
+    using Type = MpmcRing<Value_>;
+};
+
+template <typename Value_>
+struct ChannelRing<Value_, ChannelKind::Spsc> {
+    using Type = SpscRing<Value_>;
+};
+
+class ChannelEvent : private FutexWaitable {
+    Mutex _mutex;
+    std::vector<Futex::Word*> _observers;
+    std::atomic<size_t> _observers_count;
+
+  public:
+    ChannelEvent()
+        : FutexWaitable(0)
+        , _observers_count(0) {}
+
+    template <typename TryComplete_>
+    bool wait(TryComplete_ const& try_complete, ICancellationHandle& handle) {
+        if (wait_until([&](u32&) { return try_complete(); }, get_infinite_deadline(), handle))
+            return true;
+
+        notify_one();
+        return false;
+    }
+
+    void notify_one() {
+        notify(false);
+    }
+
+    void notify_all() {
+        notify(true);
+    }
+
+    void attach(Futex::Word& observer);
+    void detach(Futex::Word& observer);
+
+  private:
+    void notify(bool all) {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        if (_waiters.load(std::memory_order_relaxed)) {
+            _state.fetch_add(1, std::memory_order_release);
+            if (all)
+                Futex::wake_all(_state);
+            else
+                Futex::wake_one(_state);
+        }
+
+        if (_observers_count.load(std::memory_order_relaxed))
+            notify_observers();
+    }
+
+    void notify_observers();
+};
+
+struct IChannelSelectCase {
+    virtual ~IChannelSelectCase() {}
+
+    virtual bool try_fire() = 0;
+    virtual bool is_finished() const = 0;
+
+    virtual ChannelEvent& get_event() = 0;
+};
+
+Optional<size_t> select(IChannelSelectCase* const* cases, size_t count, ICancellationHandle& handle);
+}
+
+// close() is linearizable with send(): every send() that succeeded is still delivered to receivers, and receive()
+// reports the end of the stream only once those values are drained. Capacity is rounded up to a power of two, at least 2.
+template <typename Value_, ChannelKind Kind_ = ChannelKind::Mpmc>
+class Channel {
+    using Ring = typename detail::ChannelRing<Value_, Kind_>::Type;
+
+    template <typename, ChannelKind, typename>
+    friend class detail::ChannelReceiveCase;
+
+    template <typename, ChannelKind, typename>
+    friend class detail::ChannelSendCase;
+
+  private:
+    Ring _ring;
+    detail::ChannelEvent _readable;
+    detail::ChannelEvent _writable;
+
+  public:
+    explicit Channel(size_t capacity)
+        : _ring(capacity) {}
+
+    Channel(Channel const&) = delete;
+    Channel& operator=(Channel const&) = delete;
+
+    size_t get_capacity() const {
+        return _ring.get_capacity();
+    }
+
+    bool try_send(Value_&& value) {
+        if (!_ring.try_push(value))
+            return false;
+
+        _readable.notify_one();
+        return true;
+    }
+
+    bool send(Value_ value, ICancellationHandle& handle) {
+        bool sent = false;
+        _writable.wait([&] { return (sent = try_send(std::move(value))) || is_closed(); }, handle);
+        return sent;
+    }
+
+    template <typename Iterator_>
+    Iterator_ try_send_batch(Iterator_ begin, Iterator_ end) {
+        const Iterator_ sent_end = _ring.try_push_batch(begin, end);
+        if (sent_end != begin)
+            _readable.notify_all();
+        return sent_end;
+    }
+
+    template <typename Iterator_>
+    bool send_batch(Iterator_ begin, Iterator_ end, ICancellationHandle& handle) {
+        while (begin != end) {
+            bool progressed = false;
+            const auto try_send = [&] {
+                const Iterator_ sent_end = try_send_batch(begin, end);
+                progressed = sent_end != begin;
+                begin = sent_end;
+                return progressed || is_closed();
+            };
+
+            if (!_writable.wait(try_send, handle) || !progressed)
+                return false;
+        }
+        return true;
+    }
+
+    Optional<Value_> try_receive() {
+        Optional<Value_> result;
+        if (_ring.try_pop([&](Value_&& value) { result = std::move(value); }))
+            _writable.notify_one();
+        return result;
+    }
+
+    Optional<Value_> receive(ICancellationHandle& handle) {
+        Optional<Value_> result;
+        _readable.wait([&] { return (bool)(result = try_receive()) || is_drained(); }, handle);
+        return result;
+    }
+
+    template <typename OutputIterator_>
+    size_t try_receive_batch(OutputIterator_ out, size_t max) {
+        const size_t count = _ring.try_pop_batch(max, [&](Value_&& value) { *out++ = std::move(value); });
+        if (count)
+            _writable.notify_all();
+        return count;
+    }
+
+    template <typename OutputIterator_>
+    size_t receive_batch(OutputIterator_ out, size_t max, ICancellationHandle& handle) {
+        size_t count = 0;
+        _readable.wait([&] { return (count = try_receive_batch(out, max)) || is_drained(); }, handle);
+        return count;
+    }
+
+    void close() {
+        _ring.close();
+        _readable.notify_all();
+        _writable.notify_all();
+    }
+
+    bool is_closed() const {
+        return _ring.is_closed();
+    }
+
+  private:
+    bool is_drained() const {
+        return _ring.is_drained();
+    }
+};
+
+template <typename Value_>
+using SpscChannel = Channel<Value_, ChannelKind::Spsc>;
+
+namespace detail {
+
+template <typename Value_, ChannelKind Kind_, typename Handler_>
+class ChannelReceiveCase : public IChannelSelectCase {
+    Channel<Value_, Kind_>& _channel;
+    Handler_ _handler;
+
+  public:
+    ChannelReceiveCase(Channel<Value_, Kind_>& channel, Handler_ const& handler)
+        : _channel(channel)
+        , _handler(handler) {}
+
+    bool try_fire() override {
+        auto value = _channel.try_receive();
+        if (!value)
+            return false;
+
+        _handler(std::move(*value));
+        return true;
+    }
+
+    bool is_finished() const override {
+        return _channel.is_drained();
+    }
+
+    ChannelEvent& get_event() override {
+        return _channel._readable;
+    }
+};
+
+template <typename Value_, ChannelKind Kind_, typename Handler_>
+class ChannelSendCase : public IChannelSelectCase {
+    Channel<Value_, Kind_>& _channel;
+    Value_ _value;
+    Handler_ _handler;
+
+  public:
+    ChannelSendCase(Channel<Value_, Kind_>& channel, Value_&& value, Handler_ const& handler)
+        : _channel(channel)
+        , _value(std::move(value))
+        , _handler(handler) {}
+
+    bool try_fire() override {
+        if (!_channel.try_send(std::move(_value)))
+            return false;
+
+        _handler();
+        return true;
+    }
+
+    bool is_finished() const override {
+        return _channel.is_closed();
+    }
+
+    ChannelEvent& get_event() override {
+        return _channel._writable;
+    }
+};
+}
+
+template <typename Value_, ChannelKind Kind_, typename Handler_>
+detail::ChannelReceiveCase<Value_, Kind_, Handler_> on_receive(Channel<Value_, Kind_>& channel, Handler_ const& handler) {
+    return detail::ChannelReceiveCase<Value_, Kind_, Handler_>(channel, handler);
+}
+
+template <typename Value_, ChannelKind Kind_, typename Handler_>
+detail::ChannelSendCase<Value_, Kind_, Handler_> on_send(Channel<Value_, Kind_>& channel, Value_ value, Handler_ const& handler) {
+    return detail::ChannelSendCase<Value_, Kind_, Handler_>(channel, std::move(value), handler);
+}
+
+// Returns the index of the case that fired, or nothing if cancelled or every channel is closed.
+template <typename... Cases_>
+Optional<size_t> select(ICancellationHandle& handle, Cases_&&... cases) {
+    detail::IChannelSelectCase* const array[] = {&cases...};
+    return detail::select(array, sizeof...(Cases_), handle);
+}
+}
@@ -25,67 +25,77 @@
 #include <gum/Enum.h>
 #include <gum/concurrency/GenericMutexLock.h>
 #include <gum/concurrency/ICancellationToken.h>
+#include <gum/concurrency/ScopedCancellationCallback.h>
 #include <gum/time/Types.h>
 
 #include <condition_variable>
+#include <mutex>
 
 namespace gum {
 
 class ConditionVariable {
-    using Impl = std::condition_variable_any;
+    using Impl = std::condition_variable;
 
   public:
     GUM_ENUM(WaitResult, TimedOut, Woken);
 
   private:
+    mutable std::mutex _mutex;
     mutable Impl _impl;
 
   public:
     template <typename Mutex_>
     void wait(Mutex_ const& mutex, ICancellationHandle& handle) const {
-        Token t = handle.on_cancelled([this, &mutex] { cancel(mutex); });
-        if (!handle)
-            return;
-
-        _impl.wait(mutex);
+        do_wait(mutex, nullptr, handle);
     }
 
     template <typename Mutex_, typename Predicate_>
     void wait(Mutex_ const& mutex, Predicate_ const& predicate, ICancellationHandle& handle) const {
-        Token t = handle.on_cancelled([this, &mutex] { cancel(mutex); });
-        if (!handle)
-            return;
-
-        _impl.wait(mutex, [&] { return !handle || predicate(); });
+        while (handle && !predicate())
+            do_wait(mutex, nullptr, handle);
     }
 
     template <typename Mutex_>
     WaitResult wait_for(Mutex_ const& mutex, Duration const& duration, ICancellationHandle& handle) const {
-        Token t = handle.on_cancelled([this, &mutex] { cancel(mutex); });
-        if (!handle)
-            return WaitResult::Woken;
-
-        return _impl.wait_for(mutex, duration) == std::cv_status::timeout ? WaitResult::TimedOut : WaitResult::Woken;
+        return do_wait(mutex, &duration, handle) ? WaitResult::Woken : WaitResult::TimedOut;
     }
 
     template <typename Mutex_, typename Predicate_>
     bool wait_for(Mutex_ const& mutex, Duration const& duration, Predicate_ const& predicate, ICancellationHandle& handle) const {
-        Token t = handle.on_cancelled([this, &mutex] { cancel(mutex); });
-        if (!handle)
-            return predicate();
+        const SteadyClock::time_point deadline = SteadyClock::now() + duration;
+
+        while (handle && !predicate()) {
+            const SteadyClock::time_point now = SteadyClock::now();
+            if (now >= deadline)
+                return predicate();
 
-        return _impl.wait_for(mutex, duration, [&] { return !handle || predicate(); });
+            const Duration remaining = std::chrono::duration_cast<Duration>(deadline - now);
+            do_wait(mutex, &remaining, handle);
+        }
+        return predicate();
     }
 
     void broadcast() const {
+        { std::lock_guard<std::mutex> l(_mutex); }
         _impl.notify_all();
     }
 
   private:
     template <typename Mutex_>
-    void cancel(Mutex_ const& mutex) const {
-        GenericMutexLock<Mutex_> l(mutex);
-        broadcast();
+    bool do_wait(Mutex_ const& mutex, Duration const* timeout, ICancellationHandle& handle) const {
+        const auto waker = [this] { broadcast(); };
+        const ScopedCancellationCallback<decltype(waker)> callback(handle, waker);
+
+        std::unique_lock<std::mutex> l(_mutex);
+        if (!handle)
+            return true;
+
+        mutex.unlock();
+        const bool woken = timeout ? _impl.wait_for(l, *timeout) == std::cv_status::no_timeout : (_impl.wait(l), true);
+        l.unlock();
+        mutex.lock();
+
+        return woken;
     }
 };
 }
@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) Vladimir Golubev
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <gum/concurrency/CpuSet.h>
+
+#include <gum/string/ToString.h>
+
+#include <cctype>
+
+namespace gum {
+
+namespace {
+
+u32 parse_cpu(String const& cpu_list, size_t& pos) {
+    GUM_CHECK(pos < cpu_list.size() && std::isdigit(cpu_list.at(pos)), InvalidCpuListException(cpu_list));
+
+    u32 cpu = 0;
+    for (; pos < cpu_list.size() && std::isdigit(cpu_list.at(pos)); ++pos)
+        cpu = cpu * 10 + (cpu_list.at(pos) - '0');
+    return cpu;
+}
+}
+
+CpuSet::CpuSet(std::initializer_list<u32> cpus)
+    : _cpus(cpus) {}
+
+CpuSet CpuSet::parse(String const& cpu_list) {
+    CpuSet result;
+
+    size_t pos = 0;
+    while (pos < cpu_list.size() && !std::isspace(cpu_list.at(pos))) {
+        const u32 first = parse_cpu(cpu_list, pos);
+        u32 last = first;
+
+        if (pos < cpu_list.size() && cpu_list.at(pos) == '-')
+            last = parse_cpu(cpu_list, ++pos);
+
+        GUM_CHECK(first <= last, InvalidCpuListException(cpu_list));
+        for (u32 cpu = first; cpu <= last; ++cpu)
+            result.add(cpu);
+
+        if (pos < cpu_list.size() && cpu_list.at(pos) == ',')
+            ++pos;
+    }
+
+    return result;
+}
+
+void CpuSet::add(u32 cpu) {
+    _cpus.insert(cpu);
+}
+
+void CpuSet::add(CpuSet const& other) {
+    _cpus.insert(other._cpus.begin(), other._cpus.end());
+}
+
+bool CpuSet::contains(u32 cpu) const {
+    return _cpus.count(cpu);
+}
+
+size_t CpuSet::size() const {
+    return _cpus.size();
+}
+
+bool CpuSet::empty() const {
+    return _cpus.empty();
+}
+
+CpuSet::const_iterator CpuSet::begin() const {
+    return _cpus.begin();
+}
+
+CpuSet::const_iterator CpuSet::end() const {
+    return _cpus.end();
+}
+
+bool CpuSet::operator==(CpuSet const& other) const {
+    return _cpus == other._cpus;
+}
+
+bool CpuSet::operator!=(CpuSet const& other) const {
+    return !(*this == other);
+}
+
+String CpuSet::to_string() const {
+    String result;
+
+    for (auto iter = _cpus.begin(); iter != _cpus.end();) {
+        const u32 first = *iter;
+        u32 last = first;
+        while (++iter != _cpus.end() && *iter == last + 1)
+            ++last;
+
+        if (!result.empty())
+            result << ",";
+        result << first;
+        if (last != first)
+            result << "-" << last;
+    }
+
+    return result;
+}
+}
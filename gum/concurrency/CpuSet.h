@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) Vladimir Golubev
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <gum/Types.h>
+#include <gum/exception/Exception.h>
+#include <gum/string/String.h>
+
+#include <boost/container/flat_set.hpp>
+
+#include <initializer_list>
+
+namespace gum {
+
+GUM_DECLARE_EXCEPTION(InvalidCpuListException, "Invalid cpu list");
+
+class CpuSet {
+    using Cpus = boost::container::flat_set<u32>;
+
+  public:
+    using const_iterator = Cpus::const_iterator;
+
+  private:
+    Cpus _cpus;
+
+  public:
+    CpuSet() = default;
+    CpuSet(std::initializer_list<u32> cpus);
+
+    static CpuSet parse(String const& cpu_list);
+
+    void add(u32 cpu);
+    void add(CpuSet const& other);
+
+    bool contains(u32 cpu) const;
+
+    size_t size() const;
+    bool empty() const;
+
+    const_iterator begin() const;
+    const_iterator end() const;
+
+    bool operator==(CpuSet const& other) const;
+    bool operator!=(CpuSet const& other) const;
+
+    String to_string() const;
+};
+}
@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) Vladimir Golubev
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <gum/concurrency/CpuTopology.h>
+
+#include <gum/string/ToString.h>
+
+#include <algorithm>
+#include <fstream>
+#include <map>
+#include <thread>
+
+namespace gum {
+
+namespace {
+
+Optional<String> read_sysfs(String const& path) {
+    std::ifstream file(path.c_str());
+    std::string content;
+    if (!file || !std::getline(file, content))
+        return nullptr;
+    return String(content);
+}
+
+Optional<u32> read_sysfs_number(String const& path) {
+    Optional<String> const content = read_sysfs(path);
+    if (!content)
+        return nullptr;
+
+    try {
+        return (u32)std::stoul(content->c_str());
+    } catch (std::exception const&) {
+        return nullptr;
+    }
+}
+
+std::vector<CpuTopology::Cpu> discover_flat() {
+    std::vector<CpuTopology::Cpu> cpus;
+    for (u32 cpu = 0; cpu < std::max(1u, std::thread::hardware_concurrency()); ++cpu)
+        cpus.push_back({cpu, cpu, 0, 0});
+    return cpus;
+}
+}
+
+GUM_DEFINE_LOGGER(CpuTopology);
+
+CpuTopology::CpuTopology(std::vector<Cpu> cpus)
+    : _cpus(std::move(cpus)) {}
+
+CpuTopology const& CpuTopology::get() {
+    static CpuTopology const topology = discover();
+    return topology;
+}
+
+CpuTopology CpuTopology::discover(String const& sysfs_root) {
+    Optional<String> const online = read_sysfs(String() << sysfs_root << "/cpu/online");
+    if (!online) {
+        _logger.warning() << "Could not read cpu topology from " << sysfs_root << ", assuming a flat topology.";
+        return CpuTopology(discover_flat());
+    }
+
+    std::map<u32, u32> cpu_nodes;
+    Optional<String> const nodes = read_sysfs(String() << sysfs_root << "/node/online");
+    if (nodes)
+        for (u32 node : CpuSet::parse(*nodes))
+            if (Optional<String> const node_cpus = read_sysfs(String() << sysfs_root << "/node/node" << node << "/cpulist"))
+                for (u32 cpu : CpuSet::parse(*node_cpus))
+                    cpu_nodes.emplace(cpu, node);
+
+    std::vector<Cpu> cpus;
+    for (u32 cpu : CpuSet::parse(*online)) {
+        String const topology = String() << sysfs_root << "/cpu/cpu" << cpu << "/topology/";
+        Optional<u32> const core = read_sysfs_number(String() << topology << "core_id");
+        Optional<u32> const package = read_sysfs_number(String() << topology << "physical_package_id");
+
+        auto const node = cpu_nodes.find(cpu);
+        cpus.push_back({cpu, core ? *core : cpu, package ? *package : 0, node != cpu_nodes.end() ? node->second : 0});
+    }
+
+    return CpuTopology(std::move(cpus));
+}
+
+std::vector<CpuTopology::Cpu> const& CpuTopology::get_cpus() const {
+    return _cpus;
+}
+
+std::vector<u32> CpuTopology::get_nodes() const {
+    std::vector<u32> nodes;
+    for (auto const& cpu : _cpus)
+        if (std::find(nodes.begin(), nodes.end(), cpu.Node) == nodes.end())
+            nodes.push_back(cpu.Node);
+
+    std::sort(nodes.begin(), nodes.end());
+    return nodes;
+}
+
+CpuSet CpuTopology::get_all_cpus() const {
+    CpuSet result;
+    for (auto const& cpu : _cpus)
+        result.add(cpu.Id);
+    return result;
+}
+
+CpuSet CpuTopology::get_node_cpus(u32 node) const {
+    CpuSet result;
+    for (auto const& cpu : _cpus)
+        if (cpu.Node == node)
+            result.add(cpu.Id);
+    return result;
+}
+
+std::vector<CpuSet> CpuTopology::get_physical_cores(Optional<u32> const& node) const {
+    std::map<std::pair<u32, u32>, CpuSet> cores;
+    for (auto const& cpu : _cpus)
+        if (!node || cpu.Node == *node)
+            cores[std::make_pair(cpu.Package, cpu.Core)].add(cpu.Id);
+
+    std::vector<CpuSet> result;
+    for (auto& core : cores)
+        result.push_back(std::move(core.second));
+    return result;
+}
+
+CpuSet CpuTopology::get_one_cpu_per_core(Optional<u32> const& node) const {
+    CpuSet result;
+    for (auto const& core : get_physical_cores(node))
+        result.add(*core.begin());
+    return result;
+}
+
+String CpuTopology::to_string() const {
+    String result = String() << "CpuTopology: " << _cpus.size() << " cpus";
+    for (u32 node : get_nodes())
+        result << ", node " << node << ": " << get_node_cpus(node) << " (" << get_physical_cores(node).size() << " cores)";
+    return result;
+}
+}
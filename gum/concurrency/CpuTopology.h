@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) Vladimir Golubev
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <gum/Optional.h>
+#include <gum/concurrency/CpuSet.h>
+#include <gum/log/Logger.h>
+
+#include <vector>
+
+namespace gum {
+
+class CpuTopology {
+  public:
+    struct Cpu {
+        u32 Id;
+        u32 Core;
+        u32 Package;
+        u32 Node;
+    };
+
+  private:
+    static Logger _logger;
+
+    std::vector<Cpu> _cpus;
+
+  public:
+    explicit CpuTopology(std::vector<Cpu> cpus);
+
+    static CpuTopology const& get();
+    static CpuTopology discover(String const& sysfs_root = "/sys/devices/system");
+
+    std::vector<Cpu> const& get_cpus() const;
+    std::vector<u32> get_nodes() const;
+
+    CpuSet get_all_cpus() const;
+    CpuSet get_node_cpus(u32 node) const;
+
+    std::vector<CpuSet> get_physical_cores(Optional<u32> const& node = nullptr) const;
+    CpuSet get_one_cpu_per_core(Optional<u32> const& node = nullptr) const;
+
+    String to_string() const;
+};
+}
@@ -37,6 +37,12 @@ struct DummyCancellationHandle : public virtual ICancellationHandle {
         return Token();
     }
 
+    bool register_callback(CancellationCallback&) override {
+        return true;
+    }
+
+    void unregister_callback(CancellationCallback&) override {}
+
     DummyCancellationHandle& operator*() {
         return *this;
     }
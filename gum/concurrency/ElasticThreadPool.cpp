@@ -0,0 +1,238 @@
+/*
+ * Copyright (c) Vladimir Golubev
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <gum/concurrency/ElasticThreadPool.h>
+
+#include <gum/Try.h>
+#include <gum/async/CurrentTaskQueue.h>
+#include <gum/concurrency/DummyCancellationHandle.h>
+#include <gum/concurrency/TaskActivity.h>
+#include <gum/string/ToString.h>
+
+#include <vector>
+
+namespace gum {
+
+namespace {
+
+thread_local ElasticThreadPool* t_current_pool = nullptr;
+
+SteadyClock::rep get_now() {
+    return SteadyClock::now().time_since_epoch().count();
+}
+}
+
+GUM_DEFINE_LOGGER(ElasticThreadPool);
+
+ElasticThreadPool::BlockingSection::BlockingSection()
+    : _pool(t_current_pool) {
+    if (_pool)
+        _pool->enter_blocking();
+}
+
+ElasticThreadPool::BlockingSection::BlockingSection(ElasticThreadPool& pool)
+    : _pool(&pool) {
+    _pool->enter_blocking();
+}
+
+ElasticThreadPool::BlockingSection::~BlockingSection() {
+    if (_pool)
+        _pool->leave_blocking();
+}
+
+ElasticThreadPool::ElasticThreadPool(String const& name, ElasticThreadPoolSettings const& settings)
+    : _name(name)
+    , _settings(settings)
+    , _queue(settings.Limits)
+    , _thread_count(0)
+    , _idle_count(0)
+    , _blocked_count(0)
+    , _last_progress(get_now())
+    , _next_thread_id(0)
+    , _stopping(false) {
+    GUM_CHECK(_settings.MaxThreads && _settings.MinThreads <= _settings.MaxThreads, ArgumentException("MaxThreads", _settings.MaxThreads));
+
+    MutexLock l(_mutex);
+    while (_threads.size() < _settings.MinThreads)
+        spawn_thread();
+}
+
+ElasticThreadPool::~ElasticThreadPool() {
+    Threads threads;
+    {
+        MutexLock l(_mutex);
+        _stopping = true;
+    }
+
+    for (;;) {
+        {
+            MutexLock l(_mutex);
+            threads.swap(_threads);
+            _thread_count.store(0, std::memory_order_relaxed);
+            threads.insert(std::make_move_iterator(_retired.begin()), std::make_move_iterator(_retired.end()));
+            _retired.clear();
+        }
+
+        if (threads.empty())
+            break;
+        threads.clear();
+    }
+}
+
+void ElasticThreadPool::push(Task&& task) {
+    const PushResult result = on_pushed(_queue.push(wrap(std::move(task)), *DummyCancellationHandle()));
+    GUM_CHECK(result != PushResult::Rejected, TaskQueueOverflowException(String() << *this << ", limits: " << _queue.get_limits()));
+}
+
+PushResult ElasticThreadPool::try_push(Task&& task) {
+    return on_pushed(_queue.try_push(wrap(std::move(task))));
+}
+
+PushResult ElasticThreadPool::try_push(CoalescingKey key, Task&& task) {
+    return on_pushed(_queue.try_push(key, wrap(std::move(task))));
+}
+
+PushResult ElasticThreadPool::push(Task&& task, ICancellationHandle& handle) {
+    return on_pushed(_queue.push(wrap(std::move(task)), handle));
+}
+
+PushResult ElasticThreadPool::push(CoalescingKey key, Task&& task, ICancellationHandle& handle) {
+    return on_pushed(_queue.push(key, wrap(std::move(task)), handle));
+}
+
+TaskQueueLimits ElasticThreadPool::get_limits() const {
+    return _queue.get_limits();
+}
+
+size_t ElasticThreadPool::size() const {
+    return _queue.size();
+}
+
+size_t ElasticThreadPool::get_thread_count() const {
+    return _thread_count.load(std::memory_order_relaxed);
+}
+
+size_t ElasticThreadPool::get_idle_count() const {
+    return _idle_count.load(std::memory_order_relaxed);
+}
+
+String ElasticThreadPool::to_string() const {
+    return String() << "ElasticThreadPool " << _name << " { threads: " << get_thread_count() << ", idle: " << get_idle_count()
+                    << ", blocked: " << _blocked_count.load(std::memory_order_relaxed) << " }";
+}
+
+PushResult ElasticThreadPool::on_pushed(PushResult result) {
+    if (result == PushResult::Queued && !_idle_count.load(std::memory_order_relaxed))
+        grow_if_stalled();
+    return result;
+}
+
+void ElasticThreadPool::thread_func(u64 id, ICancellationHandle& handle) {
+    const CurrentTaskQueue::Scope scope(*this);
+    t_current_pool = this;
+
+    while (handle) {
+        _idle_count.fetch_add(1, std::memory_order_relaxed);
+        Optional<Task> const task = _queue.pop_for(_settings.IdleTimeout, handle);
+        _idle_count.fetch_sub(1, std::memory_order_relaxed);
+
+        if (task)
+            (*task)();
+        else if (handle && try_retire(id))
+            return;
+    }
+}
+
+bool ElasticThreadPool::try_retire(u64 id) {
+    MutexLock l(_mutex);
+
+    if (_stopping || _threads.size() <= _settings.MinThreads + _blocked_count.load())
+        return false;
+
+    _thread_count.store(_threads.size() - 1);
+    if (_queue.size()) {
+        _thread_count.store(_threads.size());
+        return false;
+    }
+
+    auto const iter = _threads.find(id);
+    _retired.emplace(id, std::move(iter->second));
+    _threads.erase(iter);
+
+    _logger.debug() << *_retired[id] << " retired after " << std::chrono::duration_cast<Milliseconds>(_settings.IdleTimeout).count() << "ms idle";
+    return true;
+}
+
+void ElasticThreadPool::enter_blocking() {
+    _blocked_count.fetch_add(1);
+    if (!_idle_count.load(std::memory_order_relaxed) && _queue.size())
+        grow(true);
+}
+
+void ElasticThreadPool::leave_blocking() {
+    _blocked_count.fetch_sub(1);
+}
+
+void ElasticThreadPool::grow_if_stalled() {
+    const auto stalled_for = SteadyClock::duration(get_now() - _last_progress.load(std::memory_order_relaxed));
+    if (stalled_for >= _settings.GrowthLatency || _thread_count.load(std::memory_order_relaxed) <= _blocked_count.load())
+        grow(false);
+}
+
+void ElasticThreadPool::grow(bool compensating) {
+    Threads retired;
+
+    MutexLock l(_mutex);
+    retired.swap(_retired);
+
+    if (_stopping || _threads.size() >= _settings.MaxThreads + _blocked_count.load())
+        return;
+
+    const auto now = SteadyClock::now();
+    const bool starving = _threads.size() <= _blocked_count.load();
+    if (!compensating && !starving && now - _last_growth < _settings.GrowthLatency)
+        return;
+
+    _last_growth = now;
+    spawn_thread();
+}
+
+void ElasticThreadPool::spawn_thread() {
+    const u64 id = _next_thread_id++;
+    _threads.emplace(id, gum::make_unique<Thread>(String() << _name << ":" << id, [this, id](ICancellationHandle& handle) { thread_func(id, handle); }));
+    _thread_count.store(_threads.size(), std::memory_order_relaxed);
+}
+
+ElasticThreadPool::Task ElasticThreadPool::wrap(Task&& task) {
+    std::type_info const* const origin = &task.target_type();
+    return [this, origin, task = std::move(task), enqueued = get_now()] {
+        const auto now = get_now();
+        _last_progress.store(now, std::memory_order_relaxed);
+
+        if (SteadyClock::duration(now - enqueued) >= _settings.GrowthLatency && _queue.size() && !_idle_count.load(std::memory_order_relaxed))
+            grow(false);
+
+        const TaskActivity::Scope activity(*origin);
+        GUM_TRY_LEVEL("Uncaught exception in pool task", LogLevel::Error, task());
+    };
+}
+}
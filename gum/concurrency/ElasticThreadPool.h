@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) Vladimir Golubev
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <gum/async/IBoundedTaskQueue.h>
+#include <gum/async/TaskDeque.h>
+#include <gum/concurrency/Thread.h>
+
+#include <algorithm>
+#include <atomic>
+#include <map>
+
+namespace gum {
+
+struct ElasticThreadPoolSettings {
+    size_t MinThreads = 1;
+    size_t MaxThreads = std::max(1u, std::thread::hardware_concurrency());
+    Duration GrowthLatency = std::chrono::milliseconds(1);
+    Duration IdleTimeout = std::chrono::seconds(10);
+    TaskQueueLimits Limits;
+};
+
+class ElasticThreadPool : public virtual IBoundedTaskQueue {
+    using Self = ElasticThreadPool;
+
+    using Threads = std::map<u64, ThreadUniquePtr>;
+
+  public:
+    class BlockingSection {
+        ElasticThreadPool* _pool;
+
+      public:
+        BlockingSection();
+        explicit BlockingSection(ElasticThreadPool& pool);
+        ~BlockingSection();
+
+        BlockingSection(BlockingSection const&) = delete;
+        BlockingSection& operator=(BlockingSection const&) = delete;
+    };
+
+  private:
+    static Logger _logger;
+
+    String _name;
+    ElasticThreadPoolSettings _settings;
+
+    TaskDeque _queue;
+
+    std::atomic<size_t> _thread_count;
+    std::atomic<size_t> _idle_count;
+    std::atomic<size_t> _blocked_count;
+    std::atomic<SteadyClock::rep> _last_progress;
+
+    Mutex _mutex;
+    Threads _threads;
+    Threads _retired;
+    u64 _next_thread_id;
+    SteadyClock::time_point _last_growth;
+    bool _stopping;
+
+  public:
+    ElasticThreadPool(String const& name, ElasticThreadPoolSettings const& settings = ElasticThreadPoolSettings());
+    ~ElasticThreadPool();
+
+    ElasticThreadPool(ElasticThreadPool const&) = delete;
+    ElasticThreadPool& operator=(ElasticThreadPool const&) = delete;
+
+    void push(Task&& task) override;
+
+    PushResult try_push(Task&& task) override;
+    PushResult try_push(CoalescingKey key, Task&& task) override;
+
+    PushResult push(Task&& task, ICancellationHandle& handle) override;
+    PushResult push(CoalescingKey key, Task&& task, ICancellationHandle& handle) override;
+
+    TaskQueueLimits get_limits() const override;
+    size_t size() const override;
+
+    size_t get_thread_count() const;
+    size_t get_idle_count() const;
+
+    String to_string() const;
+
+  private:
+    PushResult on_pushed(PushResult result);
+
+    void thread_func(u64 id, ICancellationHandle& handle);
+    bool try_retire(u64 id);
+
+    void enter_blocking();
+    void leave_blocking();
+
+    void grow_if_stalled();
+    void grow(bool compensating);
+    void spawn_thread();
+
+    Task wrap(Task&& task);
+};
+}
@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) Vladimir Golubev
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <gum/concurrency/Futex.h>
+
+#if defined(GUM_HAS_FUTEX)
+#include <gum/backend/posix/concurrency/Futex.h>
+#else
+#include <gum/backend/dummy/concurrency/Futex.h>
+#endif
+
+#include <limits>
+
+namespace gum {
+
+namespace {
+
+#if defined(GUM_HAS_FUTEX)
+using FutexImpl = posix::Futex;
+#else
+using FutexImpl = dummy::Futex;
+#endif
+}
+
+void Futex::wait(Word& word, u32 expected) {
+    FutexImpl::wait(word, expected, nullptr);
+}
+
+bool Futex::wait_for(Word& word, u32 expected, Duration const& timeout) {
+    return FutexImpl::wait(word, expected, timeout);
+}
+
+void Futex::wake_one(Word& word) {
+    FutexImpl::wake(word, 1);
+}
+
+void Futex::wake_all(Word& word) {
+    FutexImpl::wake(word, std::numeric_limits<int>::max());
+}
+}
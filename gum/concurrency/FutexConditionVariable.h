@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) Vladimir Golubev
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <gum/Enum.h>
+#include <gum/concurrency/Futex.h>
+#include <gum/concurrency/Mutex.h>
+#include <gum/concurrency/ScopedCancellationCallback.h>
+
+namespace gum {
+
+class FutexConditionVariable {
+  public:
+    GUM_ENUM(WaitResult, TimedOut, Woken);
+
+  private:
+    mutable Futex::Word _sequence;
+    mutable std::atomic<u32> _waiters;
+
+  public:
+    FutexConditionVariable()
+        : _sequence(0)
+        , _waiters(0) {}
+
+    FutexConditionVariable(FutexConditionVariable const&) = delete;
+    FutexConditionVariable& operator=(FutexConditionVariable const&) = delete;
+
+    void wait(Mutex const& mutex, ICancellationHandle& handle) const {
+        do_wait(mutex, nullptr, handle);
+    }
+
+    template <typename Predicate_>
+    void wait(Mutex const& mutex, Predicate_ const& predicate, ICancellationHandle& handle) const {
+        while (handle && !predicate())
+            do_wait(mutex, nullptr, handle);
+    }
+
+    WaitResult wait_for(Mutex const& mutex, Duration const& duration, ICancellationHandle& handle) const {
+        return do_wait(mutex, &duration, handle) ? WaitResult::Woken : WaitResult::TimedOut;
+    }
+
+    template <typename Predicate_>
+    bool wait_for(Mutex const& mutex, Duration const& duration, Predicate_ const& predicate, ICancellationHandle& handle) const {
+        const SteadyClock::time_point deadline = SteadyClock::now() + duration;
+
+        while (handle && !predicate()) {
+            const SteadyClock::time_point now = SteadyClock::now();
+            if (now >= deadline)
+                return false;
+
+            const Duration remaining = std::chrono::duration_cast<Duration>(deadline - now);
+            do_wait(mutex, &remaining, handle);
+        }
+        return predicate();
+    }
+
+    void signal() const {
+        _sequence.fetch_add(1);
+        if (_waiters.load())
+            Futex::wake_one(_sequence);
+    }
+
+    void broadcast() const {
+        _sequence.fetch_add(1);
+        if (_waiters.load())
+            Futex::wake_all(_sequence);
+    }
+
+  private:
+    bool do_wait(Mutex const& mutex, Duration const* timeout, ICancellationHandle& handle) const {
+        const u32 sequence = _sequence.load();
+
+        const auto waker = [this] { broadcast(); };
+        const ScopedCancellationCallback<decltype(waker)> callback(handle, waker);
+        if (!handle)
+            return true;
+
+        _waiters.fetch_add(1);
+        mutex.unlock();
+
+        const bool woken = timeout ? Futex::wait_for(_sequence, sequence, *timeout) : (Futex::wait(_sequence, sequence), true);
+
+        mutex.lock();
+        _waiters.fetch_sub(1, std::memory_order_relaxed);
+        return woken;
+    }
+};
+}
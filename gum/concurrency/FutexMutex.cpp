@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) Vladimir Golubev
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <gum/concurrency/FutexMutex.h>
+
+#include <gum/concurrency/CpuRelax.h>
+#include <gum/concurrency/MutexLogger.h>
+#include <gum/diagnostics/Backtrace.h>
+#include <gum/string/ToString.h>
+#include <gum/time/ElapsedTime.h>
+
+#include <algorithm>
+
+namespace gum {
+
+bool FutexMutex::spin() {
+    const s32 estimate = _spin_estimate.load(std::memory_order_relaxed);
+    const s32 limit = std::min(MaxSpinCount, estimate * 2 + 10);
+
+    s32 spins = 0;
+    bool acquired = false;
+    for (; spins < limit && !acquired; ++spins) {
+        cpu_relax();
+        acquired = _state.load(std::memory_order_relaxed) == Unlocked && try_acquire();
+    }
+
+    _spin_estimate.store(estimate + (spins - estimate) / 8, std::memory_order_relaxed);
+    return acquired;
+}
+
+void FutexMutex::lock_contended() {
+    if (spin())
+        return;
+
+#if defined(GUM_CONCURRENCY_USES_UNTIMED_LOCKS)
+    while (_state.exchange(Contended, std::memory_order_acquire) != Unlocked)
+        Futex::wait(_state, Contended);
+#else
+    const Seconds Threshold = Seconds(3);
+    const ElapsedTime elapsed;
+
+    while (_state.exchange(Contended, std::memory_order_acquire) != Unlocked) {
+        if (!Futex::wait_for(_state, Contended, Threshold)) {
+            MutexLogger::get().warning() << "Could not lock mutex " << this << " owned by: " << _owner.load(std::memory_order_relaxed) << " for "
+                                         << elapsed.elapsed_to<Seconds>() << "."
+                                         << " There is probably a deadlock.\nBacktrace: " << Backtrace();
+        }
+    }
+#endif
+}
+}
@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) Vladimir Golubev
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <gum/concurrency/Futex.h>
+#include <gum/concurrency/LockOrderValidator.h>
+#include <gum/concurrency/LockProfiler.h>
+#include <gum/concurrency/ThreadId.h>
+
+namespace gum {
+
+class FutexMutex {
+    enum State : u32 { Unlocked, Locked, Contended };
+
+    static constexpr s32 MaxSpinCount = 100;
+
+  private:
+    Futex::Word _state;
+    std::atomic<s32> _spin_estimate;
+    std::atomic<ThreadId> _owner;
+    LockProfileRecorder _profile;
+
+  public:
+    FutexMutex()
+        : _state(Unlocked)
+        , _spin_estimate(0)
+        , _owner(ThreadId()) {}
+
+    ~FutexMutex() {
+        _profile.forget(this);
+        LockOrderValidator::on_destroyed(this);
+    }
+
+    FutexMutex(FutexMutex const&) = delete;
+    FutexMutex& operator=(FutexMutex const&) = delete;
+
+    void lock() {
+        LockOrderValidator::on_acquiring(this);
+
+        if (GUM_UNLIKELY(LockProfiler::is_enabled()))
+            _profile.lock(this, [this] { return try_acquire(); }, [this] { lock_contended(); });
+        else if (!try_acquire())
+            lock_contended();
+
+        on_acquired();
+    }
+
+    bool try_lock() {
+        if (!try_acquire())
+            return false;
+
+        on_acquired();
+        return true;
+    }
+
+    void unlock() {
+        LockOrderValidator::on_released(this);
+        _profile.unlock(this);
+        _owner.store(ThreadId(), std::memory_order_relaxed);
+
+        if (_state.exchange(Unlocked, std::memory_order_release) == Contended)
+            Futex::wake_one(_state);
+    }
+
+  private:
+    void on_acquired() {
+        _owner.store(std::this_thread::get_id(), std::memory_order_relaxed);
+        LockOrderValidator::on_acquired(this);
+    }
+
+    bool try_acquire() {
+        u32 expected = Unlocked;
+        return _state.compare_exchange_strong(expected, Locked, std::memory_order_acquire, std::memory_order_relaxed);
+    }
+
+    bool spin();
+    void lock_contended();
+};
+}
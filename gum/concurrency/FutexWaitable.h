@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) Vladimir Golubev
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <gum/concurrency/Futex.h>
+#include <gum/concurrency/ScopedCancellationCallback.h>
+
+namespace gum {
+namespace detail {
+
+class FutexWaitable {
+  protected:
+    static constexpr u32 GenerationUnit = 1u << 24;
+    static constexpr u32 PayloadMask = GenerationUnit - 1;
+
+  protected:
+    mutable Futex::Word _state;
+    mutable std::atomic<u32> _waiters;
+
+  protected:
+    explicit FutexWaitable(u32 payload)
+        : _state(payload)
+        , _waiters(0) {}
+
+    FutexWaitable(FutexWaitable const&) = delete;
+    FutexWaitable& operator=(FutexWaitable const&) = delete;
+
+    static u32 get_payload(u32 state) {
+        return state & PayloadMask;
+    }
+
+    template <typename TryComplete_>
+    bool wait_until(TryComplete_ const& try_complete, SteadyClock::time_point deadline, ICancellationHandle& handle) const {
+        u32 state = _state.load(std::memory_order_acquire);
+        if (try_complete(state))
+            return true;
+
+        const auto waker = [this] { interrupt_waiters(); };
+        const ScopedCancellationCallback<decltype(waker)> callback(handle, waker);
+
+        _waiters.fetch_add(1);
+
+        bool completed = false;
+        while (!(completed = try_complete(state = _state.load())) && handle) {
+            if (deadline == get_infinite_deadline()) {
+                Futex::wait(_state, state);
+                continue;
+            }
+
+            const SteadyClock::time_point now = SteadyClock::now();
+            if (now >= deadline)
+                break;
+
+            Futex::wait_for(_state, state, std::chrono::duration_cast<Duration>(deadline - now));
+        }
+
+        _waiters.fetch_sub(1, std::memory_order_relaxed);
+        return completed;
+    }
+
+    static SteadyClock::time_point get_deadline(Duration const& duration) {
+        return SteadyClock::now() + duration;
+    }
+
+    static SteadyClock::time_point get_infinite_deadline() {
+        return SteadyClock::time_point::max();
+    }
+
+    void wake_one() const {
+        if (_waiters.load())
+            Futex::wake_one(_state);
+    }
+
+    void wake_all() const {
+        if (_waiters.load())
+            Futex::wake_all(_state);
+    }
+
+  private:
+    void interrupt_waiters() const {
+        _state.fetch_add(GenerationUnit);
+        Futex::wake_all(_state);
+    }
+};
+}
+}
@@ -23,6 +23,7 @@
 #pragma once
 
 #include <gum/IBoolean.h>
+#include <gum/concurrency/CancellationCallback.h>
 #include <gum/time/Types.h>
 #include <gum/token/Token.h>
 
@@ -37,6 +38,15 @@ struct ICancellationHandle : public virtual IBoolean {
     virtual void sleep(Duration const& duration) const = 0;
 
     virtual Token on_cancelled(CancellationHandler const& cancellationHandler) = 0;
+
+    virtual bool register_callback(CancellationCallback& callback) {
+        callback._fallback_registration = on_cancelled([&callback] { callback.handle_cancellation(); });
+        return (bool)*this;
+    }
+
+    virtual void unregister_callback(CancellationCallback& callback) {
+        callback._fallback_registration.release();
+    }
 };
 
 struct ICancellationToken : public virtual ICancellationHandle {
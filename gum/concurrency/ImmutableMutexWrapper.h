@@ -43,6 +43,10 @@ class ImmutableMutexWrapper {
         _impl.lock();
     }
 
+    bool try_lock() const {
+        return _impl.try_lock();
+    }
+
     void unlock() const {
         _impl.unlock();
     }
@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) Vladimir Golubev
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <gum/concurrency/FutexWaitable.h>
+
+namespace gum {
+
+class Latch : private detail::FutexWaitable {
+  public:
+    explicit Latch(u32 count)
+        : FutexWaitable(count) {
+        GUM_CHECK(count <= PayloadMask, ArgumentException("count", count));
+    }
+
+    void count_down(u32 count = 1) {
+        u32 state = _state.load(std::memory_order_relaxed);
+        do {
+            GUM_CHECK(count <= get_payload(state), LogicError("Latch counted down below zero"));
+        } while (!_state.compare_exchange_weak(state, state - count, std::memory_order_release, std::memory_order_relaxed));
+
+        if (get_payload(state) == count)
+            wake_all();
+    }
+
+    bool try_wait() const {
+        return !get_payload(_state.load(std::memory_order_acquire));
+    }
+
+    bool wait(ICancellationHandle& handle) const {
+        return wait_until([](u32 state) { return !get_payload(state); }, get_infinite_deadline(), handle);
+    }
+
+    bool wait_for(Duration const& duration, ICancellationHandle& handle) const {
+        return wait_until([](u32 state) { return !get_payload(state); }, get_deadline(duration), handle);
+    }
+
+    bool arrive_and_wait(ICancellationHandle& handle) {
+        count_down();
+        return wait(handle);
+    }
+};
+}
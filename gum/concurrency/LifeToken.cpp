@@ -22,12 +22,11 @@
 
 #include <gum/concurrency/LifeToken.h>
 
-#include <gum/concurrency/ConditionVariable.h>
-#include <gum/concurrency/DummyCancellationHandle.h>
-#include <gum/concurrency/Mutex.h>
-#include <gum/concurrency/Thread.h>
-
-#include <atomic>
+#include <gum/concurrency/Futex.h>
+#include <gum/concurrency/LockOrderValidator.h>
+#include <gum/diagnostics/Backtrace.h>
+#include <gum/log/LoggerSingleton.h>
+#include <gum/time/ElapsedTime.h>
 
 namespace gum {
 
@@ -41,72 +40,72 @@ struct ILifeHandleImpl : public virtual ILifeHandle {
 GUM_DECLARE_REF(ILifeHandleImpl);
 
 class SynchronizedLifeHandle : public virtual ILifeHandleImpl {
-    mutable std::atomic<bool> _alive;
-    mutable ThreadInfoPtr _owner;
+    static constexpr u32 ReleasedFlag = 1u << 31;
+    static constexpr u32 WaitingFlag = 1u << 30;
+    static constexpr u32 ActiveCallsMask = WaitingFlag - 1;
 
-    Mutex _mutex;
-    ConditionVariable _condition_varaible;
+  private:
+    mutable Futex::Word _state;
 
   public:
     SynchronizedLifeHandle()
-        : _alive(true) {}
-
-    bool lock() const override {
-        if (!_alive)
-            return false;
+        : _state(0) {}
 
-        MutexLock l(_mutex);
-
-        if (!_alive)
-            return false;
+    ~SynchronizedLifeHandle() {
+        LockOrderValidator::on_destroyed(this);
+    }
 
-        wait();
+    bool lock() const override {
+        LockOrderValidator::on_acquiring(this);
 
-        _owner = Thread::get_own_info();
+        u32 state = _state.load(std::memory_order_relaxed);
+        do {
+            if (state & ReleasedFlag)
+                return false;
+        } while (!_state.compare_exchange_weak(state, state + 1, std::memory_order_acquire, std::memory_order_relaxed));
 
+        LockOrderValidator::on_acquired(this);
         return true;
     }
 
     void unlock() const override {
-        if (!_alive)
-            return;
-
-        MutexLock l(_mutex);
+        LockOrderValidator::on_released(this);
 
-        if (!_alive)
-            return;
-
-        _owner = nullptr;
-        _condition_varaible.broadcast();
+        const u32 state = _state.fetch_sub(1, std::memory_order_release) - 1;
+        if ((state & WaitingFlag) && !(state & ActiveCallsMask))
+            Futex::wake_all(_state);
     }
 
     void release() override {
-        if (!_alive)
-            return;
-
-        MutexLock l(_mutex);
-
-        if (!_alive)
-            return;
+        LockOrderValidator::on_acquiring(this);
 
-        wait();
+        u32 state = _state.fetch_or(ReleasedFlag, std::memory_order_acquire) | ReleasedFlag;
+        while (state & ActiveCallsMask) {
+            if (!(state & WaitingFlag) && !_state.compare_exchange_weak(state, state | WaitingFlag, std::memory_order_acquire))
+                continue;
 
-        _alive = false;
+            wait(state | WaitingFlag);
+            state = _state.load(std::memory_order_acquire);
+        }
     }
 
   private:
-    void wait() const {
+#if defined(GUM_CONCURRENCY_USES_UNTIMED_LOCKS)
+    void wait(u32 state) const {
+        Futex::wait(_state, state);
+    }
+#else
+    void wait(u32 state) const {
         const Seconds Threshold = Seconds(3);
         const ElapsedTime elapsed;
 
-        while (_owner) {
-            if (_condition_varaible.wait_for(_mutex, Threshold, *DummyCancellationHandle()) == ConditionVariable::WaitResult::Woken)
-                continue;
-
-            LifeTokenLogger::get().warning() << "Could not acquire life token owned by: " << _owner << " for " << elapsed.elapsed_to<Seconds>() << "."
+        while (!Futex::wait_for(_state, state, Threshold)) {
+            LifeTokenLogger::get().warning() << "Could not release life token with " << (state & ActiveCallsMask) << " active calls for "
+                                             << elapsed.elapsed_to<Seconds>() << "."
                                              << " There is probably a deadlock.\nBacktrace: " << Backtrace();
         }
     }
+#endif
 };
 GUM_DECLARE_REF(SynchronizedLifeHandle);
 
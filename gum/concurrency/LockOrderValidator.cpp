@@ -0,0 +1,205 @@
+/*
+ * Copyright (c) Vladimir Golubev
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <gum/concurrency/LockOrderValidator.h>
+
+#if defined(GUM_CONCURRENCY_VALIDATES_LOCK_ORDER)
+
+#include <gum/Optional.h>
+#include <gum/concurrency/MutexLogger.h>
+#include <gum/diagnostics/Backtrace.h>
+#include <gum/string/ToString.h>
+
+#include <algorithm>
+#include <array>
+#include <deque>
+#include <mutex>
+#include <set>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace gum {
+
+namespace {
+
+class LockGraph {
+    struct LockNode {
+        std::unordered_map<void const*, RawBacktrace> Successors;
+        std::unordered_set<void const*> Predecessors;
+    };
+
+    using LockPath = std::vector<void const*>;
+
+  private:
+    std::mutex _mutex;
+    std::unordered_map<void const*, LockNode> _nodes;
+    std::set<std::pair<void const*, void const*>> _reported;
+
+  public:
+    Optional<String> add_edge(void const* held, void const* acquiring) {
+        std::lock_guard<std::mutex> l(_mutex);
+
+        LockNode& node = _nodes[held];
+        if (node.Successors.count(acquiring))
+            return nullptr;
+
+        LockPath path;
+        if (find_path(acquiring, held, path)) {
+            if (!_reported.emplace(held, acquiring).second)
+                return nullptr;
+            return get_report(held, acquiring, path);
+        }
+
+        node.Successors.emplace(acquiring, RawBacktrace());
+        _nodes[acquiring].Predecessors.insert(held);
+        return nullptr;
+    }
+
+    void remove(void const* lock) {
+        std::lock_guard<std::mutex> l(_mutex);
+
+        auto const iter = _nodes.find(lock);
+        if (iter == _nodes.end())
+            return;
+
+        for (auto const& successor : iter->second.Successors)
+            _nodes[successor.first].Predecessors.erase(lock);
+        for (auto const& predecessor : iter->second.Predecessors)
+            _nodes[predecessor].Successors.erase(lock);
+
+        _nodes.erase(iter);
+    }
+
+  private:
+    bool find_path(void const* from, void const* to, LockPath& path) const {
+        std::unordered_map<void const*, void const*> parents{{from, nullptr}};
+        std::deque<void const*> queue{from};
+
+        while (!queue.empty()) {
+            void const* const lock = queue.front();
+            queue.pop_front();
+
+            if (lock == to) {
+                for (void const* step = to; step; step = parents[step])
+                    path.push_back(step);
+                std::reverse(path.begin(), path.end());
+                return true;
+            }
+
+            auto const iter = _nodes.find(lock);
+            if (iter == _nodes.end())
+                continue;
+
+            for (auto const& successor : iter->second.Successors)
+                if (parents.emplace(successor.first, lock).second)
+                    queue.push_back(successor.first);
+        }
+        return false;
+    }
+
+    String get_report(void const* held, void const* acquiring, LockPath const& path) const {
+        String report = String() << "Lock order inversion: acquiring " << acquiring << " while holding " << held << ".\nBacktrace: " << RawBacktrace()
+                                 << "\nReverse order was established earlier:";
+
+        for (size_t i = 1; i < path.size(); ++i)
+            report << "\n  " << path[i - 1] << " -> " << path[i] << " at: " << _nodes.at(path[i - 1]).Successors.at(path[i]);
+
+        return report;
+    }
+};
+
+LockGraph& get_lock_graph() {
+    static LockGraph* const graph = new LockGraph();
+    return *graph;
+}
+
+constexpr size_t MaxHeldLocks = 64;
+
+thread_local std::array<void const*, MaxHeldLocks> t_held_locks;
+thread_local size_t t_held_lock_count = 0;
+thread_local bool t_validating = false;
+
+class ValidatingScope {
+  public:
+    ValidatingScope() {
+        t_validating = true;
+    }
+
+    ~ValidatingScope() {
+        t_validating = false;
+    }
+};
+
+bool is_held(void const* lock) {
+    auto const end = t_held_locks.begin() + std::min(t_held_lock_count, MaxHeldLocks);
+    return std::find(t_held_locks.begin(), end, lock) != end;
+}
+}
+
+void LockOrderValidator::on_acquiring(void const* lock) {
+    if (t_validating || !t_held_lock_count || t_held_lock_count > MaxHeldLocks || is_held(lock))
+        return;
+
+    const ValidatingScope scope;
+
+    Optional<String> const report = get_lock_graph().add_edge(t_held_locks[t_held_lock_count - 1], lock);
+    if (report)
+        MutexLogger::get().error() << *report;
+}
+
+void LockOrderValidator::on_acquired(void const* lock) {
+    if (t_validating)
+        return;
+
+    if (t_held_lock_count < MaxHeldLocks)
+        t_held_locks[t_held_lock_count] = lock;
+    ++t_held_lock_count;
+}
+
+void LockOrderValidator::on_released(void const* lock) {
+    if (t_validating || !t_held_lock_count)
+        return;
+
+    if (t_held_lock_count > MaxHeldLocks) {
+        --t_held_lock_count;
+        return;
+    }
+
+    auto const end = t_held_locks.begin() + t_held_lock_count;
+    auto const iter = std::find(std::make_reverse_iterator(end), t_held_locks.rend(), lock);
+    if (iter == t_held_locks.rend())
+        return;
+
+    std::copy(iter.base(), end, std::prev(iter.base()));
+    --t_held_lock_count;
+}
+
+void LockOrderValidator::on_destroyed(void const* lock) {
+    if (t_validating)
+        return;
+
+    const ValidatingScope scope;
+    get_lock_graph().remove(lock);
+}
+}
+
+#endif
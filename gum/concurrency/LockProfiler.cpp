@@ -0,0 +1,254 @@
+/*
+ * Copyright (c) Vladimir Golubev
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <gum/concurrency/LockProfiler.h>
+
+#include <gum/Optional.h>
+#include <gum/diagnostics/Backtrace.h>
+#include <gum/string/ToString.h>
+
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace gum {
+
+namespace {
+
+class LatencyHistogram {
+    static constexpr size_t BucketCount = 48;
+
+  private:
+    std::array<u64, BucketCount> _buckets;
+    u64 _count;
+    Nanoseconds _total;
+    Nanoseconds _max;
+
+  public:
+    LatencyHistogram()
+        : _buckets()
+        , _count()
+        , _total()
+        , _max() {}
+
+    void add(Nanoseconds const& value) {
+        ++_buckets[get_bucket_index(value)];
+        ++_count;
+        _total += value;
+        _max = std::max(_max, value);
+    }
+
+    Nanoseconds get_total() const {
+        return _total;
+    }
+
+    Nanoseconds get_percentile(double percentile) const {
+        const u64 rank = static_cast<u64>(percentile * _count);
+
+        u64 seen = 0;
+        for (size_t i = 0; i < BucketCount; ++i) {
+            seen += _buckets[i];
+            if (seen > rank)
+                return std::min(_max, Nanoseconds(u64(1) << i));
+        }
+        return _max;
+    }
+
+    String to_string() const {
+        if (!_count)
+            return "{ }";
+
+        return String() << "{ avg: " << Nanoseconds(_total.count() / _count).count() << "ns, p50: " << get_percentile(0.5).count()
+                        << "ns, p99: " << get_percentile(0.99).count() << "ns, max: " << _max.count() << "ns }";
+    }
+
+  private:
+    static size_t get_bucket_index(Nanoseconds const& value) {
+        size_t index = 0;
+        for (u64 ns = std::max<s64>(value.count(), 0); ns; ns >>= 1)
+            ++index;
+        return std::min(index, BucketCount - 1);
+    }
+};
+
+struct CallSiteStats {
+    u64 Count = 0;
+    Nanoseconds WaitTime = Nanoseconds();
+};
+
+struct LockSiteStats {
+    u64 Acquisitions = 0;
+    u64 ContendedAcquisitions = 0;
+    LatencyHistogram WaitTime;
+    LatencyHistogram HoldTime;
+    std::map<RawBacktrace, CallSiteStats> CallSites;
+};
+
+class ProfileTable {
+    using LockSites = std::unordered_map<void const*, LockSiteStats>;
+
+    struct Shard {
+        std::mutex Mutex;
+        LockSites Sites;
+    };
+
+    static constexpr size_t ShardCount = 16;
+
+  private:
+    std::array<Shard, ShardCount> _shards;
+
+  public:
+    template <typename Callable_>
+    void update(void const* lock, Callable_ const& callable) {
+        Shard& shard = get_shard(lock);
+
+        std::lock_guard<std::mutex> l(shard.Mutex);
+        callable(shard.Sites[lock]);
+    }
+
+    void remove(void const* lock) {
+        Shard& shard = get_shard(lock);
+
+        std::lock_guard<std::mutex> l(shard.Mutex);
+        shard.Sites.erase(lock);
+    }
+
+    std::vector<std::pair<void const*, LockSiteStats>> get_snapshot() {
+        std::vector<std::pair<void const*, LockSiteStats>> snapshot;
+        for (auto& shard : _shards) {
+            std::lock_guard<std::mutex> l(shard.Mutex);
+            snapshot.insert(snapshot.end(), shard.Sites.begin(), shard.Sites.end());
+        }
+        return snapshot;
+    }
+
+    void clear() {
+        for (auto& shard : _shards) {
+            std::lock_guard<std::mutex> l(shard.Mutex);
+            shard.Sites.clear();
+        }
+    }
+
+  private:
+    Shard& get_shard(void const* lock) {
+        return _shards[(reinterpret_cast<uintptr_t>(lock) >> 4) % ShardCount];
+    }
+};
+
+ProfileTable& get_profile_table() {
+    static ProfileTable* const table = new ProfileTable();
+    return *table;
+}
+
+thread_local size_t t_slow_acquisitions = 0;
+}
+
+GUM_DEFINE_LOGGER(LockProfiler);
+
+std::atomic<bool> LockProfiler::_enabled(false);
+std::atomic<size_t> LockProfiler::_sample_period(DefaultSamplePeriod);
+
+void LockProfiler::enable(size_t sample_period) {
+    GUM_CHECK(sample_period, ArgumentException("sample_period", sample_period));
+
+    _sample_period = sample_period;
+    _enabled = true;
+}
+
+void LockProfiler::disable() {
+    _enabled = false;
+}
+
+void LockProfiler::reset() {
+    get_profile_table().clear();
+}
+
+void LockProfiler::on_acquired(void const* lock, Clock::duration const& wait_time, bool contended) {
+    const Nanoseconds wait = std::chrono::duration_cast<Nanoseconds>(wait_time);
+
+    Optional<RawBacktrace> backtrace;
+    if (contended && ++t_slow_acquisitions % _sample_period.load(std::memory_order_relaxed) == 0)
+        backtrace = RawBacktrace();
+
+    get_profile_table().update(lock, [&](LockSiteStats& stats) {
+        ++stats.Acquisitions;
+        if (!contended)
+            return;
+
+        ++stats.ContendedAcquisitions;
+        stats.WaitTime.add(wait);
+
+        if (backtrace) {
+            CallSiteStats& call_site = stats.CallSites[*backtrace];
+            ++call_site.Count;
+            call_site.WaitTime += wait;
+        }
+    });
+}
+
+void LockProfiler::on_released(void const* lock, Clock::duration const& hold_time) {
+    const Nanoseconds hold = std::chrono::duration_cast<Nanoseconds>(hold_time);
+    get_profile_table().update(lock, [&](LockSiteStats& stats) { stats.HoldTime.add(hold); });
+}
+
+void LockProfiler::on_destroyed(void const* lock) {
+    get_profile_table().remove(lock);
+}
+
+String LockProfiler::get_report(size_t top_count) {
+    auto snapshot = get_profile_table().get_snapshot();
+    std::sort(snapshot.begin(), snapshot.end(), [](auto const& l, auto const& r) { return l.second.WaitTime.get_total() > r.second.WaitTime.get_total(); });
+    snapshot.resize(std::min(snapshot.size(), top_count));
+
+    String report = "Lock contention report:";
+    for (auto const& site : snapshot) {
+        LockSiteStats const& stats = site.second;
+        report << "\n  lock " << site.first << ": acquisitions: " << stats.Acquisitions << ", contended: " << stats.ContendedAcquisitions
+               << ", total wait: " << std::chrono::duration_cast<Microseconds>(stats.WaitTime.get_total()).count() << "us"
+               << "\n    wait: " << stats.WaitTime << "\n    hold: " << stats.HoldTime;
+
+        std::vector<std::pair<RawBacktrace, CallSiteStats>> call_sites(stats.CallSites.begin(), stats.CallSites.end());
+        std::sort(call_sites.begin(), call_sites.end(), [](auto const& l, auto const& r) { return l.second.WaitTime > r.second.WaitTime; });
+        call_sites.resize(std::min<size_t>(call_sites.size(), 5));
+
+        for (auto const& call_site : call_sites)
+            report << "\n    sampled " << call_site.second.Count << " times, wait " << std::chrono::duration_cast<Microseconds>(call_site.second.WaitTime).count()
+                   << "us at: " << call_site.first.to_string();
+    }
+    return report;
+}
+
+void LockProfiler::log_report(size_t top_count) {
+    _logger.info() << get_report(top_count);
+}
+
+void LockProfiler::write_report(String const& path, size_t top_count) {
+    std::ofstream file(path.c_str());
+    GUM_CHECK(file, Exception(String() << "Could not open lock profile report file " << path));
+
+    file << get_report(top_count).c_str() << std::endl;
+}
+}
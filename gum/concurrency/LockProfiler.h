@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) Vladimir Golubev
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <gum/log/Logger.h>
+#include <gum/string/String.h>
+#include <gum/time/Types.h>
+
+#include <atomic>
+
+namespace gum {
+
+class LockProfiler {
+  public:
+    using Clock = SteadyClock;
+    using TimePoint = Clock::time_point;
+
+    static constexpr size_t DefaultSamplePeriod = 16;
+    static constexpr size_t DefaultTopCount = 20;
+
+  private:
+    static Logger _logger;
+
+    static std::atomic<bool> _enabled;
+    static std::atomic<size_t> _sample_period;
+
+  public:
+    static bool is_enabled() {
+        return _enabled.load(std::memory_order_relaxed);
+    }
+
+    static void enable(size_t sample_period = DefaultSamplePeriod);
+    static void disable();
+    static void reset();
+
+    static void on_acquired(void const* lock, Clock::duration const& wait_time, bool contended);
+    static void on_released(void const* lock, Clock::duration const& hold_time);
+    // Drops the stats of a destroyed lock, so a new lock at the same address starts from scratch
+    static void on_destroyed(void const* lock);
+
+    static String get_report(size_t top_count = DefaultTopCount);
+    static void log_report(size_t top_count = DefaultTopCount);
+    static void write_report(String const& path, size_t top_count = DefaultTopCount);
+};
+
+class LockProfileRecorder {
+    LockProfiler::TimePoint _acquired_at;
+    bool _recorded;
+
+  public:
+    LockProfileRecorder()
+        : _acquired_at()
+        , _recorded(false) {}
+
+    template <typename TryLock_, typename Lock_>
+    void lock(void const* lock, TryLock_ const& try_lock, Lock_ const& do_lock) {
+        const LockProfiler::TimePoint started = LockProfiler::Clock::now();
+
+        const bool contended = !try_lock();
+        if (contended)
+            do_lock();
+
+        _acquired_at = LockProfiler::Clock::now();
+        _recorded = true;
+        LockProfiler::on_acquired(lock, _acquired_at - started, contended);
+    }
+
+    void unlock(void const* lock) {
+        if (_acquired_at == LockProfiler::TimePoint())
+            return;
+
+        LockProfiler::on_released(lock, LockProfiler::Clock::now() - _acquired_at);
+        _acquired_at = LockProfiler::TimePoint();
+    }
+
+    void forget(void const* lock) {
+        if (_recorded)
+            LockProfiler::on_destroyed(lock);
+    }
+};
+}
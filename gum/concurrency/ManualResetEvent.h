@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) Vladimir Golubev
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <gum/concurrency/FutexWaitable.h>
+
+namespace gum {
+
+class ManualResetEvent : private detail::FutexWaitable {
+    static constexpr u32 SetFlag = 1;
+
+  public:
+    explicit ManualResetEvent(bool set = false)
+        : FutexWaitable(set ? SetFlag : 0) {}
+
+    bool is_set() const {
+        return _state.load(std::memory_order_acquire) & SetFlag;
+    }
+
+    void set() {
+        if (!(_state.fetch_or(SetFlag) & SetFlag))
+            wake_all();
+    }
+
+    void reset() {
+        _state.fetch_and(~SetFlag, std::memory_order_relaxed);
+    }
+
+    bool wait(ICancellationHandle& handle) const {
+        return wait_until([](u32 state) { return state & SetFlag; }, get_infinite_deadline(), handle);
+    }
+
+    bool wait_for(Duration const& duration, ICancellationHandle& handle) const {
+        return wait_until([](u32 state) { return state & SetFlag; }, get_deadline(duration), handle);
+    }
+};
+}
@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) Vladimir Golubev
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <gum/concurrency/CacheLine.h>
+
+#include <atomic>
+
+namespace gum {
+
+struct MpscQueueHook {
+    std::atomic<MpscQueueHook*> mpsc_next;
+
+  public:
+    MpscQueueHook()
+        : mpsc_next(nullptr) {}
+};
+
+template <typename Node_, size_t Alignment_ = CacheLineSize>
+class IntrusiveMpscQueue {
+    using Hook = MpscQueueHook;
+
+  private:
+    alignas(Alignment_) std::atomic<Hook*> _head;
+    alignas(Alignment_) Hook* _tail;
+    Hook _stub;
+
+  public:
+    IntrusiveMpscQueue()
+        : _head(&_stub)
+        , _tail(&_stub) {}
+
+    IntrusiveMpscQueue(IntrusiveMpscQueue const&) = delete;
+    IntrusiveMpscQueue& operator=(IntrusiveMpscQueue const&) = delete;
+
+    void push(Node_* node) {
+        push_hook(node);
+    }
+
+    // Single consumer only. May return null while a concurrent push is between linking steps.
+    Node_* pop() {
+        Hook* tail = _tail;
+        Hook* next = tail->mpsc_next.load(std::memory_order_acquire);
+
+        if (tail == &_stub) {
+            if (!next)
+                return nullptr;
+
+            _tail = next;
+            tail = next;
+            next = next->mpsc_next.load(std::memory_order_acquire);
+        }
+
+        if (next) {
+            _tail = next;
+            return static_cast<Node_*>(tail);
+        }
+
+        if (tail != _head.load(std::memory_order_acquire))
+            return nullptr;
+
+        push_hook(&_stub);
+
+        next = tail->mpsc_next.load(std::memory_order_acquire);
+        if (next) {
+            _tail = next;
+            return static_cast<Node_*>(tail);
+        }
+
+        return nullptr;
+    }
+
+    bool empty() const {
+        return _tail == &_stub && !_stub.mpsc_next.load(std::memory_order_acquire);
+    }
+
+  private:
+    void push_hook(Hook* hook) {
+        hook->mpsc_next.store(nullptr, std::memory_order_relaxed);
+        Hook* const prev = _head.exchange(hook, std::memory_order_acq_rel);
+        prev->mpsc_next.store(hook, std::memory_order_release);
+    }
+};
+}
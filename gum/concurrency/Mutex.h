@@ -22,6 +22,7 @@
 
 #pragma once
 
+#include <gum/concurrency/FutexMutex.h>
 #include <gum/concurrency/GenericMutexLock.h>
 #include <gum/concurrency/ImmutableMutexWrapper.h>
 #include <gum/concurrency/TimedMutexWrapper.h>
@@ -30,8 +31,12 @@
 
 namespace gum {
 
-using Mutex = ImmutableMutexWrapper<TimedMutexWrapper<std::timed_mutex>>;
+using Mutex = ImmutableMutexWrapper<FutexMutex>;
+#if defined(GUM_CONCURRENCY_USES_UNTIMED_LOCKS)
+using RecursiveMutex = ImmutableMutexWrapper<TimedMutexWrapper<std::recursive_mutex>>;
+#else
 using RecursiveMutex = ImmutableMutexWrapper<TimedMutexWrapper<std::recursive_timed_mutex>>;
+#endif
 
 using MutexLock = GenericMutexLock<Mutex>;
 using RecursiveMutexLock = GenericMutexLock<RecursiveMutex>;
@@ -0,0 +1,249 @@
+/*
+ * Copyright (c) Vladimir Golubev
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <gum/concurrency/Rcu.h>
+
+#include <gum/concurrency/CacheLine.h>
+#include <gum/concurrency/Mutex.h>
+#include <gum/token/FunctionToken.h>
+
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <limits>
+#include <thread>
+
+namespace gum {
+
+namespace {
+
+struct ReaderRecord {
+    std::atomic<u64> Epoch;
+    size_t Nesting;
+    std::atomic<bool> InUse;
+    ReaderRecord* Next;
+    u8 Padding[CacheLineSize];
+
+  public:
+    ReaderRecord()
+        : Epoch(0)
+        , Nesting(0)
+        , InUse(true)
+        , Next(nullptr) {}
+};
+
+struct RetiredObject {
+    u64 Epoch;
+    Rcu::Deleter Deleter;
+};
+
+class RcuDomain {
+    static constexpr u64 QuiescentEpoch = 0;
+    static constexpr CoalescingKey ReclaimKey = 0x52435552454c4149;
+    static constexpr size_t InlineReclaimThreshold = 64;
+
+  private:
+    std::atomic<u64> _epoch;
+    std::atomic<ReaderRecord*> _readers;
+
+    Mutex _mutex;
+    std::deque<RetiredObject> _retired;
+    size_t _inline_reclaim_threshold;
+    IBoundedTaskQueuePtr _reclaimer;
+
+  public:
+    RcuDomain()
+        : _epoch(QuiescentEpoch + 1)
+        , _readers(nullptr)
+        , _inline_reclaim_threshold(InlineReclaimThreshold) {}
+
+    ReaderRecord* acquire_record() {
+        for (ReaderRecord* record = _readers.load(std::memory_order_acquire); record; record = record->Next) {
+            bool in_use = false;
+            if (!record->InUse.load(std::memory_order_relaxed) && record->InUse.compare_exchange_strong(in_use, true, std::memory_order_acquire))
+                return record;
+        }
+
+        ReaderRecord* const record = new ReaderRecord();
+        record->Next = _readers.load(std::memory_order_relaxed);
+        while (!_readers.compare_exchange_weak(record->Next, record, std::memory_order_release, std::memory_order_relaxed))
+            ;
+        return record;
+    }
+
+    void release_record(ReaderRecord* record) {
+        record->Nesting = 0;
+        record->Epoch.store(QuiescentEpoch, std::memory_order_release);
+        record->InUse.store(false, std::memory_order_release);
+    }
+
+    void enter(ReaderRecord& record) {
+        if (record.Nesting++)
+            return;
+
+        record.Epoch.store(_epoch.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+
+    void exit(ReaderRecord& record) {
+        GUM_CHECK(record.Nesting, LogicError("Rcu read lock is not held"));
+
+        if (!--record.Nesting)
+            record.Epoch.store(QuiescentEpoch, std::memory_order_release);
+    }
+
+    void retire(Rcu::Deleter&& deleter) {
+        IBoundedTaskQueuePtr reclaimer;
+        bool reclaim_inline = false;
+        {
+            MutexLock l(_mutex);
+            _retired.push_back({_epoch.load(), std::move(deleter)});
+            reclaimer = _reclaimer;
+            reclaim_inline = !reclaimer && _retired.size() >= _inline_reclaim_threshold;
+        }
+
+        if (reclaimer)
+            reclaimer->try_push(ReclaimKey, [this] { reclaim(); });
+        else if (reclaim_inline)
+            reclaim();
+    }
+
+    size_t reclaim() {
+        advance();
+        const u64 safe_epoch = get_oldest_reader_epoch();
+
+        std::deque<RetiredObject> reclaimed;
+        {
+            MutexLock l(_mutex);
+            while (!_retired.empty() && _retired.front().Epoch < safe_epoch) {
+                reclaimed.push_back(std::move(_retired.front()));
+                _retired.pop_front();
+            }
+            _inline_reclaim_threshold = std::max(InlineReclaimThreshold, _retired.size() * 2);
+        }
+
+        for (auto& object : reclaimed)
+            object.Deleter();
+
+        return reclaimed.size();
+    }
+
+    void synchronize() {
+        const u64 epoch = advance();
+
+        while (get_oldest_reader_epoch() < epoch)
+            std::this_thread::yield();
+
+        reclaim();
+    }
+
+    Token set_reclaimer(IBoundedTaskQueueRef const& queue) {
+        {
+            MutexLock l(_mutex);
+            GUM_CHECK(!_reclaimer, LogicError("Rcu reclaimer is already set"));
+            _reclaimer = queue;
+        }
+
+        queue->try_push(ReclaimKey, [this] { reclaim(); });
+
+        return make_token<FunctionToken>([this] {
+            MutexLock l(_mutex);
+            _reclaimer = nullptr;
+        });
+    }
+
+  private:
+    u64 advance() {
+        const u64 epoch = _epoch.fetch_add(1) + 1;
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        return epoch;
+    }
+
+    u64 get_oldest_reader_epoch() const {
+        u64 oldest = std::numeric_limits<u64>::max();
+
+        for (ReaderRecord* record = _readers.load(std::memory_order_acquire); record; record = record->Next) {
+            const u64 epoch = record->Epoch.load();
+            if (epoch != QuiescentEpoch)
+                oldest = std::min(oldest, epoch);
+        }
+        return oldest;
+    }
+};
+
+RcuDomain& get_rcu_domain() {
+    static RcuDomain* const domain = new RcuDomain();
+    return *domain;
+}
+
+class ReaderRecordHolder {
+    ReaderRecord* _record = nullptr;
+
+  public:
+    ~ReaderRecordHolder() {
+        if (_record)
+            get_rcu_domain().release_record(_record);
+    }
+
+    ReaderRecord& get() {
+        if (!_record)
+            _record = get_rcu_domain().acquire_record();
+        return *_record;
+    }
+
+    bool is_read_locked() const {
+        return _record && _record->Nesting;
+    }
+};
+
+thread_local ReaderRecordHolder t_reader_record;
+}
+
+void Rcu::read_lock() {
+    get_rcu_domain().enter(t_reader_record.get());
+}
+
+void Rcu::read_unlock() {
+    get_rcu_domain().exit(t_reader_record.get());
+}
+
+bool Rcu::is_read_locked() {
+    return t_reader_record.is_read_locked();
+}
+
+void Rcu::retire(Deleter&& deleter) {
+    get_rcu_domain().retire(std::move(deleter));
+}
+
+size_t Rcu::reclaim() {
+    return get_rcu_domain().reclaim();
+}
+
+void Rcu::synchronize() {
+    GUM_CHECK(!is_read_locked(), LogicError("Rcu::synchronize called inside a read-side critical section"));
+    get_rcu_domain().synchronize();
+}
+
+Token Rcu::set_reclaimer(IBoundedTaskQueueRef const& queue) {
+    return get_rcu_domain().set_reclaimer(queue);
+}
+}
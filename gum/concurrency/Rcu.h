@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) Vladimir Golubev
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <gum/async/IBoundedTaskQueue.h>
+#include <gum/token/Token.h>
+
+#include <functional>
+
+namespace gum {
+
+class Rcu {
+  public:
+    using Deleter = std::function<void()>;
+
+  public:
+    static void read_lock();
+    static void read_unlock();
+    static bool is_read_locked();
+
+    template <typename Value_>
+    static void retire(Value_* ptr) {
+        retire(ptr, std::default_delete<Value_>());
+    }
+
+    template <typename Value_, typename Deleter_>
+    static void retire(Value_* ptr, Deleter_ deleter) {
+        retire(Deleter([ptr, deleter] { deleter(ptr); }));
+    }
+
+    // Without a reclaimer set, retire() reclaims inline once enough objects are pending.
+    static void retire(Deleter&& deleter);
+
+    static size_t reclaim();
+    static void synchronize();
+
+    static Token set_reclaimer(IBoundedTaskQueueRef const& queue);
+};
+
+class RcuReadLock {
+  public:
+    RcuReadLock() {
+        Rcu::read_lock();
+    }
+
+    ~RcuReadLock() {
+        Rcu::read_unlock();
+    }
+
+    RcuReadLock(RcuReadLock const&) = delete;
+    RcuReadLock& operator=(RcuReadLock const&) = delete;
+};
+}
@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) Vladimir Golubev
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <gum/concurrency/Mutex.h>
+#include <gum/concurrency/Rcu.h>
+#include <gum/smartpointer/UniquePtr.h>
+
+#include <atomic>
+
+namespace gum {
+
+template <typename Value_>
+class RcuPtr {
+    std::atomic<Value_*> _value;
+    Mutex _update_mutex;
+
+  public:
+    RcuPtr()
+        : _value(nullptr) {}
+
+    explicit RcuPtr(UniquePtr<Value_>&& value)
+        : _value(value.release()) {}
+
+    ~RcuPtr() {
+        delete _value.load(std::memory_order_relaxed);
+    }
+
+    RcuPtr(RcuPtr const&) = delete;
+    RcuPtr& operator=(RcuPtr const&) = delete;
+
+    Value_ const* get() const {
+        return _value.load(std::memory_order_acquire);
+    }
+
+    void reset(UniquePtr<Value_>&& value) {
+        MutexLock l(_update_mutex);
+        replace(std::move(value));
+    }
+
+    template <typename Updater_>
+    void update(Updater_ const& updater) {
+        MutexLock l(_update_mutex);
+
+        Value_ const* const current = _value.load(std::memory_order_relaxed);
+        UniquePtr<Value_> value = current ? make_unique<Value_>(*current) : make_unique<Value_>();
+        updater(*value);
+        replace(std::move(value));
+    }
+
+  private:
+    void replace(UniquePtr<Value_>&& value) {
+        Value_* const previous = _value.exchange(value.release());
+        if (previous)
+            Rcu::retire(previous);
+    }
+};
+}
@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) Vladimir Golubev
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <gum/concurrency/ReaderBiasedRwMutex.h>
+
+#include <array>
+#include <thread>
+
+namespace gum {
+
+namespace {
+
+constexpr size_t ReaderSlotBits = 12;
+constexpr size_t ReaderSlotCount = size_t(1) << ReaderSlotBits;
+constexpr size_t MaxFastReadsPerThread = 8;
+constexpr SteadyClock::rep BiasInhibitionMultiplier = 9;
+
+using ReaderSlot = std::atomic<ReaderBiasedRwMutex const*>;
+using ReaderSlots = std::array<ReaderSlot, ReaderSlotCount>;
+
+ReaderSlots& get_reader_slots() {
+    static ReaderSlots slots{};
+    return slots;
+}
+
+thread_local char t_reader_tag;
+thread_local std::array<ReaderSlot*, MaxFastReadsPerThread> t_fast_reads;
+thread_local size_t t_fast_read_count = 0;
+
+ReaderSlot& get_reader_slot(ReaderBiasedRwMutex const* mutex) {
+    const u64 key = reinterpret_cast<uintptr_t>(&t_reader_tag) ^ (reinterpret_cast<uintptr_t>(mutex) >> 4);
+    return get_reader_slots()[(key * 0x9E3779B97F4A7C15ull) >> (64 - ReaderSlotBits)];
+}
+}
+
+ReaderBiasedRwMutex::ReaderBiasedRwMutex()
+    : _read_biased(true)
+    , _bias_inhibited_until(0) {}
+
+bool ReaderBiasedRwMutex::try_lock_shared_fast() {
+    if (!_read_biased.load(std::memory_order_relaxed) || t_fast_read_count == MaxFastReadsPerThread)
+        return false;
+
+    ReaderSlot& slot = get_reader_slot(this);
+    ReaderBiasedRwMutex const* expected = nullptr;
+    if (!slot.compare_exchange_strong(expected, this))
+        return false;
+
+    if (!_read_biased.load()) {
+        slot.store(nullptr, std::memory_order_release);
+        return false;
+    }
+
+    t_fast_reads[t_fast_read_count++] = &slot;
+    return true;
+}
+
+bool ReaderBiasedRwMutex::unlock_shared_fast() {
+    for (size_t i = t_fast_read_count; i-- > 0;) {
+        ReaderSlot* const slot = t_fast_reads[i];
+        if (slot->load(std::memory_order_relaxed) != this)
+            continue;
+
+        slot->store(nullptr, std::memory_order_release);
+        t_fast_reads[i] = t_fast_reads[--t_fast_read_count];
+        return true;
+    }
+    return false;
+}
+
+void ReaderBiasedRwMutex::restore_read_bias() {
+    if (_read_biased.load(std::memory_order_relaxed))
+        return;
+
+    if (SteadyClock::now().time_since_epoch().count() >= _bias_inhibited_until.load(std::memory_order_relaxed))
+        _read_biased.store(true, std::memory_order_release);
+}
+
+void ReaderBiasedRwMutex::revoke_read_bias() {
+    if (!_read_biased.load(std::memory_order_relaxed))
+        return;
+
+    const SteadyClock::time_point start = SteadyClock::now();
+    _read_biased.store(false);
+
+    for (ReaderSlot& slot : get_reader_slots())
+        while (slot.load() == this)
+            std::this_thread::yield();
+
+    const SteadyClock::time_point now = SteadyClock::now();
+    _bias_inhibited_until.store((now + (now - start) * BiasInhibitionMultiplier).time_since_epoch().count(), std::memory_order_relaxed);
+}
+}
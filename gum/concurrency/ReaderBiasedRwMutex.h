@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) Vladimir Golubev
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <gum/time/Types.h>
+
+#include <atomic>
+#include <shared_mutex>
+
+namespace gum {
+
+class ReaderBiasedRwMutex {
+    std::shared_timed_mutex _impl;
+
+    std::atomic<bool> _read_biased;
+    std::atomic<SteadyClock::rep> _bias_inhibited_until;
+
+  public:
+    ReaderBiasedRwMutex();
+
+    ReaderBiasedRwMutex(ReaderBiasedRwMutex const&) = delete;
+    ReaderBiasedRwMutex& operator=(ReaderBiasedRwMutex const&) = delete;
+
+    void lock() {
+        _impl.lock();
+        revoke_read_bias();
+    }
+
+    bool try_lock() {
+        if (!_impl.try_lock())
+            return false;
+
+        revoke_read_bias();
+        return true;
+    }
+
+    bool try_lock_for(Duration const& duration) {
+        if (!_impl.try_lock_for(duration))
+            return false;
+
+        revoke_read_bias();
+        return true;
+    }
+
+    void unlock() {
+        _impl.unlock();
+    }
+
+    void lock_shared() {
+        if (try_lock_shared_fast())
+            return;
+
+        _impl.lock_shared();
+        restore_read_bias();
+    }
+
+    bool try_lock_shared() {
+        if (try_lock_shared_fast())
+            return true;
+
+        if (!_impl.try_lock_shared())
+            return false;
+
+        restore_read_bias();
+        return true;
+    }
+
+    bool try_lock_shared_for(Duration const& duration) {
+        if (try_lock_shared_fast())
+            return true;
+
+        if (!_impl.try_lock_shared_for(duration))
+            return false;
+
+        restore_read_bias();
+        return true;
+    }
+
+    void unlock_shared() {
+        if (!unlock_shared_fast())
+            _impl.unlock_shared();
+    }
+
+  private:
+    bool try_lock_shared_fast();
+    bool unlock_shared_fast();
+
+    void restore_read_bias();
+    void revoke_read_bias();
+};
+}
@@ -22,17 +22,17 @@
 
 #pragma once
 
-#include <gum/concurrency/GenericMutexLock.h>
 #include <gum/concurrency/ImmutableMutexWrapper.h>
+#include <gum/concurrency/ReaderBiasedRwMutex.h>
 #include <gum/concurrency/TimedMutexWrapper.h>
 
-#include <shared_mutex>
+#include <utility>
 
 namespace gum {
 
 namespace detail {
 
-using RwMutexImpl = std::shared_timed_mutex;
+using RwMutexImpl = ReaderBiasedRwMutex;
 
 class ExclusiveTimedMutex {
     detail::RwMutexImpl& _impl;
@@ -41,6 +41,14 @@ class ExclusiveTimedMutex {
     ExclusiveTimedMutex(detail::RwMutexImpl& impl)
         : _impl(impl) {}
 
+    void lock() {
+        _impl.lock();
+    }
+
+    bool try_lock() {
+        return _impl.try_lock();
+    }
+
     bool try_lock_for(Duration const& duration) {
         return _impl.try_lock_for(duration);
     }
@@ -48,6 +56,10 @@ class ExclusiveTimedMutex {
     void unlock() {
         _impl.unlock();
     }
+
+    RwMutexImpl const& get_impl() const {
+        return _impl;
+    }
 };
 using ExclusiveMutex = TimedMutexWrapper<detail::ExclusiveTimedMutex>;
 
@@ -58,6 +70,14 @@ class SharedTimedMutex {
     SharedTimedMutex(detail::RwMutexImpl& impl)
         : _impl(impl) {}
 
+    void lock() {
+        _impl.lock_shared();
+    }
+
+    bool try_lock() {
+        return _impl.try_lock_shared();
+    }
+
     bool try_lock_for(Duration const& duration) {
         return _impl.try_lock_shared_for(duration);
     }
@@ -65,8 +85,42 @@ class SharedTimedMutex {
     void unlock() {
         _impl.unlock_shared();
     }
+
+    RwMutexImpl const& get_impl() const {
+        return _impl;
+    }
 };
 using SharedMutex = TimedMutexWrapper<detail::SharedTimedMutex>;
+
+inline void const* get_lock_site(ExclusiveTimedMutex const& mutex) {
+    return &mutex.get_impl();
+}
+
+inline void const* get_lock_site(SharedTimedMutex const& mutex) {
+    return &mutex.get_impl();
+}
+
+inline void forget_lock_site(ExclusiveTimedMutex const&, LockProfileRecorder&) {}
+inline void forget_lock_site(SharedTimedMutex const&, LockProfileRecorder&) {}
+
+// Owns the wrapper returned by RwMutex::get_exclusive/get_shared, which would otherwise die at the end of the full-expression
+template <typename Mutex_>
+class RwMutexLock {
+    Mutex_ _mutex;
+
+  public:
+    RwMutexLock(Mutex_&& mutex)
+        : _mutex(std::move(mutex)) {
+        _mutex.lock();
+    }
+
+    ~RwMutexLock() {
+        _mutex.unlock();
+    }
+
+    RwMutexLock(RwMutexLock const&) = delete;
+    RwMutexLock& operator=(RwMutexLock const&) = delete;
+};
 }
 
 using ExclusiveMutex = ImmutableMutexWrapper<detail::ExclusiveMutex>;
@@ -76,6 +130,17 @@ class RwMutex {
     mutable detail::RwMutexImpl _impl;
 
   public:
+    RwMutex() = default;
+
+    ~RwMutex() {
+        if (GUM_UNLIKELY(LockProfiler::is_enabled()))
+            LockProfiler::on_destroyed(&_impl);
+        LockOrderValidator::on_destroyed(&_impl);
+    }
+
+    RwMutex(RwMutex const&) = delete;
+    RwMutex& operator=(RwMutex const&) = delete;
+
     ExclusiveMutex get_exclusive() const {
         return detail::ExclusiveMutex(_impl);
     }
@@ -85,6 +150,6 @@ class RwMutex {
     }
 };
 
-using ExclusiveMutexLock = GenericMutexLock<ExclusiveMutex>;
-using SharedMutexLock = GenericMutexLock<SharedMutex>;
+using ExclusiveMutexLock = detail::RwMutexLock<ExclusiveMutex>;
+using SharedMutexLock = detail::RwMutexLock<SharedMutex>;
 }
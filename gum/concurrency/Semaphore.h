@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) Vladimir Golubev
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <gum/concurrency/FutexWaitable.h>
+
+namespace gum {
+
+class Semaphore : private detail::FutexWaitable {
+  public:
+    static constexpr u32 MaxCount = PayloadMask;
+
+  public:
+    explicit Semaphore(u32 count = 0)
+        : FutexWaitable(count) {
+        GUM_CHECK(count <= MaxCount, ArgumentException("count", count));
+    }
+
+    u32 get_count() const {
+        return get_payload(_state.load(std::memory_order_relaxed));
+    }
+
+    void release(u32 count = 1) {
+        u32 state = _state.load(std::memory_order_relaxed);
+        do {
+            GUM_CHECK(count <= MaxCount - get_payload(state), LogicError("Semaphore count overflow"));
+        } while (!_state.compare_exchange_weak(state, state + count, std::memory_order_release, std::memory_order_relaxed));
+
+        if (count == 1)
+            wake_one();
+        else
+            wake_all();
+    }
+
+    bool try_acquire() {
+        u32 state = _state.load(std::memory_order_relaxed);
+        return try_take(state);
+    }
+
+    bool acquire(ICancellationHandle& handle) {
+        return wait_until([this](u32& state) { return try_take(state); }, get_infinite_deadline(), handle);
+    }
+
+    bool acquire_for(Duration const& duration, ICancellationHandle& handle) {
+        return wait_until([this](u32& state) { return try_take(state); }, get_deadline(duration), handle);
+    }
+
+  private:
+    bool try_take(u32& state) {
+        while (get_payload(state))
+            if (_state.compare_exchange_weak(state, state - 1, std::memory_order_acquire))
+                return true;
+        return false;
+    }
+};
+}
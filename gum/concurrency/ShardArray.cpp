@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) Vladimir Golubev
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <gum/concurrency/ShardArray.h>
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+namespace gum {
+namespace detail {
+
+namespace {
+
+size_t allocate_shard() {
+    static std::atomic<size_t> next_shard(0);
+    return next_shard.fetch_add(1, std::memory_order_relaxed);
+}
+
+thread_local size_t t_shard = allocate_shard();
+}
+
+size_t get_current_shard() {
+    return t_shard;
+}
+
+size_t get_default_shard_count() {
+    static const size_t count = std::max(1u, std::thread::hardware_concurrency());
+    return count;
+}
+}
+}
@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) Vladimir Golubev
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <gum/Types.h>
+#include <gum/concurrency/CacheLine.h>
+
+#include <memory>
+#include <new>
+
+namespace gum {
+namespace detail {
+
+size_t get_current_shard();
+size_t get_default_shard_count();
+
+template <typename Cell_>
+class ShardArray {
+    using PaddedCell = CacheLinePadded<Cell_>;
+
+  private:
+    std::unique_ptr<char[]> _buffer;
+    PaddedCell* _cells;
+    size_t _mask;
+
+  public:
+    explicit ShardArray(size_t count = get_default_shard_count()) {
+        size_t size = 1;
+        while (size < count)
+            size <<= 1;
+
+        _buffer.reset(new char[size * sizeof(PaddedCell) + CacheLineSize]);
+        void* storage = _buffer.get();
+        size_t space = size * sizeof(PaddedCell) + CacheLineSize;
+        _cells = static_cast<PaddedCell*>(std::align(CacheLineSize, size * sizeof(PaddedCell), storage, space));
+
+        for (size_t i = 0; i < size; ++i)
+            new (&_cells[i]) PaddedCell();
+        _mask = size - 1;
+    }
+
+    ~ShardArray() {
+        for (size_t i = 0; i <= _mask; ++i)
+            _cells[i].~PaddedCell();
+    }
+
+    ShardArray(ShardArray const&) = delete;
+    ShardArray& operator=(ShardArray const&) = delete;
+
+    size_t size() const {
+        return _mask + 1;
+    }
+
+    Cell_& get_local() {
+        return _cells[get_current_shard() & _mask].value;
+    }
+
+    template <typename Callable_>
+    void for_each(Callable_ const& callable) const {
+        for (size_t i = 0; i <= _mask; ++i)
+            callable(_cells[i].value);
+    }
+
+    template <typename Callable_>
+    void for_each(Callable_ const& callable) {
+        for (size_t i = 0; i <= _mask; ++i)
+            callable(_cells[i].value);
+    }
+};
+}
+}
@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) Vladimir Golubev
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <gum/concurrency/ShardArray.h>
+
+#include <atomic>
+
+namespace gum {
+
+namespace detail {
+
+template <typename Value_>
+class ShardedSum {
+    ShardArray<std::atomic<Value_>> _shards;
+
+  protected:
+    explicit ShardedSum(size_t shards)
+        : _shards(shards) {
+        reset();
+    }
+
+    void add(Value_ delta) {
+        _shards.get_local().fetch_add(delta, std::memory_order_relaxed);
+    }
+
+  public:
+    Value_ get() const {
+        Value_ result = 0;
+        _shards.for_each([&](std::atomic<Value_> const& shard) { result += shard.load(std::memory_order_relaxed); });
+        return result;
+    }
+
+    // Not atomic with respect to concurrent updates
+    void reset() {
+        _shards.for_each([](std::atomic<Value_>& shard) { shard.store(0, std::memory_order_relaxed); });
+    }
+
+    size_t get_shard_count() const {
+        return _shards.size();
+    }
+};
+}
+
+class ShardedCounter : public detail::ShardedSum<u64> {
+  public:
+    explicit ShardedCounter(size_t shards = detail::get_default_shard_count())
+        : ShardedSum(shards) {}
+
+    void add(u64 delta) {
+        ShardedSum::add(delta);
+    }
+
+    void increment() {
+        ShardedSum::add(1);
+    }
+};
+
+class ShardedGauge : public detail::ShardedSum<s64> {
+  public:
+    explicit ShardedGauge(size_t shards = detail::get_default_shard_count())
+        : ShardedSum(shards) {}
+
+    void add(s64 delta) {
+        ShardedSum::add(delta);
+    }
+
+    void increment() {
+        ShardedSum::add(1);
+    }
+
+    void decrement() {
+        ShardedSum::add(-1);
+    }
+};
+}
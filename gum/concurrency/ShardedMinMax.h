@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) Vladimir Golubev
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <gum/Optional.h>
+#include <gum/concurrency/ShardArray.h>
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+
+namespace gum {
+
+template <typename Value_>
+class ShardedMinMax {
+    struct Shard {
+        std::atomic<Value_> Min;
+        std::atomic<Value_> Max;
+    };
+
+  private:
+    detail::ShardArray<Shard> _shards;
+
+  public:
+    explicit ShardedMinMax(size_t shards = detail::get_default_shard_count())
+        : _shards(shards) {
+        reset();
+    }
+
+    void update(Value_ value) {
+        Shard& shard = _shards.get_local();
+
+        Value_ min = shard.Min.load(std::memory_order_relaxed);
+        while (value < min && !shard.Min.compare_exchange_weak(min, value, std::memory_order_relaxed))
+            ;
+
+        Value_ max = shard.Max.load(std::memory_order_relaxed);
+        while (value > max && !shard.Max.compare_exchange_weak(max, value, std::memory_order_relaxed))
+            ;
+    }
+
+    Optional<Value_> get_min() const {
+        const Value_ result = get_min_unchecked();
+        return result <= get_max_unchecked() ? Optional<Value_>(result) : nullptr;
+    }
+
+    Optional<Value_> get_max() const {
+        const Value_ result = get_max_unchecked();
+        return result >= get_min_unchecked() ? Optional<Value_>(result) : nullptr;
+    }
+
+    // Not atomic with respect to concurrent updates
+    void reset() {
+        _shards.for_each([](Shard& shard) {
+            shard.Min.store(std::numeric_limits<Value_>::max(), std::memory_order_relaxed);
+            shard.Max.store(std::numeric_limits<Value_>::lowest(), std::memory_order_relaxed);
+        });
+    }
+
+  private:
+    Value_ get_min_unchecked() const {
+        Value_ result = std::numeric_limits<Value_>::max();
+        _shards.for_each([&](Shard const& shard) { result = std::min(result, shard.Min.load(std::memory_order_relaxed)); });
+        return result;
+    }
+
+    Value_ get_max_unchecked() const {
+        Value_ result = std::numeric_limits<Value_>::lowest();
+        _shards.for_each([&](Shard const& shard) { result = std::max(result, shard.Max.load(std::memory_order_relaxed)); });
+        return result;
+    }
+};
+}
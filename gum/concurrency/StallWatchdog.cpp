@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) Vladimir Golubev
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <gum/concurrency/StallWatchdog.h>
+
+#include <gum/Try.h>
+
+#include <map>
+
+namespace gum {
+
+GUM_DEFINE_LOGGER(StallWatchdog);
+
+namespace {
+
+bool enable_backtrace_capture(StallWatchdogSettings const& settings) {
+    if (settings.CaptureBacktraces)
+        TaskActivity::enable_backtrace_capture();
+    return settings.CaptureBacktraces;
+}
+}
+
+StallWatchdog::StallWatchdog(StallWatchdogSettings const& settings)
+    : _settings(settings)
+    , _stalls_count(0)
+    , _capture_backtraces(enable_backtrace_capture(settings))
+    , _thread("StallWatchdog", [this](ICancellationHandle& handle) { thread_func(handle); }) {}
+
+void StallWatchdog::thread_func(ICancellationHandle& handle) {
+    std::map<u64, u64> reported;
+
+    while (handle) {
+        std::map<u64, u64> stalled;
+        for (TaskActivityInfo const& info : TaskActivity::get_all()) {
+            if (!info.CurrentTask || info.CurrentTaskElapsed < _settings.Threshold)
+                continue;
+
+            stalled.emplace(info.Id, info.CurrentTask);
+
+            const auto iter = reported.find(info.Id);
+            if (iter == reported.end() || iter->second != info.CurrentTask)
+                GUM_TRY_LEVEL("Could not report stalled task", LogLevel::Warning, report(info));
+        }
+
+        reported.swap(stalled);
+        handle.sleep(_settings.CheckInterval);
+    }
+}
+
+void StallWatchdog::report(TaskActivityInfo const& info) {
+    _stalls_count.fetch_add(1, std::memory_order_relaxed);
+
+    String message = String() << "Task stalled: " << info;
+
+    if (_capture_backtraces) {
+        const Optional<RawBacktrace> backtrace = TaskActivity::capture_backtrace(info.Id, info.CurrentTask, _settings.BacktraceTimeout);
+        message << ", backtrace: " << (backtrace ? backtrace->to_string() : std::string("<unavailable>"));
+    }
+
+    _logger.warning() << message;
+}
+}
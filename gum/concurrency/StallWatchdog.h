@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) Vladimir Golubev
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <gum/concurrency/TaskActivity.h>
+#include <gum/concurrency/Thread.h>
+
+#include <atomic>
+
+namespace gum {
+
+struct StallWatchdogSettings {
+    Duration Threshold = Seconds(1);
+    Duration CheckInterval = Milliseconds(100);
+    bool CaptureBacktraces = true;
+    Duration BacktraceTimeout = Milliseconds(100);
+};
+
+class StallWatchdog {
+    static Logger _logger;
+
+    StallWatchdogSettings _settings;
+    std::atomic<u64> _stalls_count;
+    bool _capture_backtraces;
+
+    Thread _thread;
+
+  public:
+    explicit StallWatchdog(StallWatchdogSettings const& settings = StallWatchdogSettings());
+
+    u64 get_stalls_count() const {
+        return _stalls_count.load(std::memory_order_relaxed);
+    }
+
+  private:
+    void thread_func(ICancellationHandle& handle);
+
+    void report(TaskActivityInfo const& info);
+};
+}
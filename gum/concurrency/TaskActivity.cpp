@@ -0,0 +1,289 @@
+/*
+ * Copyright (c) Vladimir Golubev
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <gum/concurrency/TaskActivity.h>
+
+#include <gum/concurrency/Mutex.h>
+#include <gum/concurrency/Thread.h>
+#include <gum/diagnostics/Demangle.h>
+
+#if defined(GUM_HAS_PTHREAD_CPU_CLOCK)
+#include <gum/backend/posix/concurrency/NativeThread.h>
+#else
+#include <gum/backend/dummy/concurrency/NativeThread.h>
+#endif
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <vector>
+
+namespace gum {
+
+namespace {
+
+#if defined(GUM_HAS_PTHREAD_CPU_CLOCK)
+using NativeThread = posix::NativeThread;
+#else
+using NativeThread = dummy::NativeThread;
+#endif
+
+SteadyClock::rep get_now() {
+    return SteadyClock::now().time_since_epoch().count();
+}
+
+Duration to_duration(SteadyClock::rep ticks) {
+    return std::chrono::duration_cast<Duration>(SteadyClock::duration(ticks));
+}
+
+// The backtrace fields are written by a signal handler on the recorded thread: it fills the frames for the latest
+// requested sequence number and then publishes that number as completed
+struct ActivityRecord {
+    u64 Id;
+    ThreadInfoRef Thread;
+    NativeThread::Handle Native;
+    NativeThread::StackBounds Stack;
+
+    size_t Depth;
+    u64 LastTask;
+    std::atomic<u64> CurrentTask;
+    std::atomic<SteadyClock::rep> TaskStarted;
+    std::atomic<std::type_info const*> TaskOrigin;
+
+    std::atomic<u64> TasksCompleted;
+    std::atomic<SteadyClock::rep> TotalTaskTime;
+    std::atomic<SteadyClock::rep> MaxTaskTime;
+
+    std::atomic<u64> BacktraceRequested;
+    std::atomic<u64> BacktraceCompleted;
+    std::array<std::atomic<uintptr_t>, RawBacktrace::MaxDepth> BacktraceFrames;
+    std::atomic<size_t> BacktraceSize;
+
+  public:
+    explicit ActivityRecord(u64 id)
+        : Id(id)
+        , Thread(gum::Thread::get_own_info())
+        , Native(NativeThread::get_current())
+        , Stack(NativeThread::get_own_stack_bounds())
+        , Depth(0)
+        , LastTask(0)
+        , CurrentTask(0)
+        , TaskStarted(0)
+        , TaskOrigin(nullptr)
+        , TasksCompleted(0)
+        , TotalTaskTime(0)
+        , MaxTaskTime(0)
+        , BacktraceRequested(0)
+        , BacktraceCompleted(0)
+        , BacktraceSize(0) {}
+};
+GUM_DECLARE_PTR(ActivityRecord);
+GUM_DECLARE_REF(ActivityRecord);
+
+class ActivityRegistry {
+    Mutex _mutex;
+    std::vector<ActivityRecordRef> _records;
+    u64 _next_id;
+
+    Mutex _capture_mutex;
+
+  public:
+    ActivityRegistry()
+        : _next_id(0) {}
+
+    ActivityRecordRef add() {
+        MutexLock l(_mutex);
+        _records.push_back(make_shared_ref<ActivityRecord>(++_next_id));
+        return _records.back();
+    }
+
+    void remove(ActivityRecord* record) {
+        MutexLock l(_mutex);
+        _records.erase(std::find_if(_records.begin(), _records.end(), [record](ActivityRecordRef const& r) { return r.get() == record; }));
+    }
+
+    template <typename Callable_>
+    void for_each(Callable_ const& callable) {
+        MutexLock l(_mutex);
+        for (ActivityRecordRef const& record : _records)
+            callable(*record);
+    }
+
+    // The predicate runs under the registry lock, so it may still signal the thread of the record it accepts
+    template <typename Predicate_>
+    ActivityRecordPtr find(Predicate_ const& predicate) {
+        MutexLock l(_mutex);
+        for (ActivityRecordRef const& record : _records)
+            if (predicate(*record))
+                return record;
+        return nullptr;
+    }
+
+    Mutex& get_capture_mutex() {
+        return _capture_mutex;
+    }
+};
+
+ActivityRegistry& get_registry() {
+    static ActivityRegistry* const registry = new ActivityRegistry();
+    return *registry;
+}
+
+thread_local ActivityRecord* t_activity_record = nullptr;
+
+class ActivityRecordHolder {
+    ActivityRecordPtr _record;
+
+  public:
+    ~ActivityRecordHolder() {
+        if (!_record)
+            return;
+
+        t_activity_record = nullptr;
+        get_registry().remove(_record.get());
+    }
+
+    ActivityRecord& get() {
+        if (!_record) {
+            _record = get_registry().add();
+            t_activity_record = _record.get();
+        }
+        return *_record;
+    }
+};
+
+thread_local ActivityRecordHolder t_activity;
+
+// Runs in a signal handler, so it only walks the interrupted stack and writes the record's fixed-size frame buffer
+void capture_own_backtrace(void* context) {
+    ActivityRecord* const record = t_activity_record;
+    if (!record)
+        return;
+
+    const u64 request = record->BacktraceRequested.load(std::memory_order_acquire);
+    if (record->BacktraceCompleted.load(std::memory_order_relaxed) == request)
+        return;
+
+    uintptr_t frames[RawBacktrace::MaxDepth];
+    const size_t size = NativeThread::get_interrupted_frames(context, record->Stack, frames, RawBacktrace::MaxDepth);
+    for (size_t i = 0; i < size; ++i)
+        record->BacktraceFrames[i].store(frames[i], std::memory_order_relaxed);
+    record->BacktraceSize.store(size, std::memory_order_relaxed);
+
+    record->BacktraceCompleted.store(request, std::memory_order_release);
+}
+}
+
+String TaskActivityInfo::to_string() const {
+    using std::chrono::duration_cast;
+
+    String result = String() << "{ thread: " << Thread;
+    if (CpuTime)
+        result << ", cpu time: " << duration_cast<Milliseconds>(*CpuTime).count() << "ms";
+
+    result << ", tasks: " << TasksCompleted << ", total task time: " << duration_cast<Milliseconds>(TotalTaskTime).count() << "ms"
+           << ", max task time: " << duration_cast<Milliseconds>(MaxTaskTime).count() << "ms";
+
+    if (CurrentTask)
+        result << ", current task: " << CurrentTaskOrigin << " for " << duration_cast<Milliseconds>(CurrentTaskElapsed).count() << "ms";
+    return result << " }";
+}
+
+TaskActivity::Scope::Scope(std::type_info const& origin) {
+    ActivityRecord& record = t_activity.get();
+    if (record.Depth++)
+        return;
+
+    record.TaskOrigin.store(&origin, std::memory_order_relaxed);
+    record.TaskStarted.store(get_now(), std::memory_order_relaxed);
+    record.CurrentTask.store(++record.LastTask, std::memory_order_release);
+}
+
+TaskActivity::Scope::~Scope() {
+    ActivityRecord& record = t_activity.get();
+    if (--record.Depth)
+        return;
+
+    const SteadyClock::rep elapsed = get_now() - record.TaskStarted.load(std::memory_order_relaxed);
+    record.CurrentTask.store(0, std::memory_order_release);
+
+    record.TasksCompleted.store(record.TasksCompleted.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    record.TotalTaskTime.store(record.TotalTaskTime.load(std::memory_order_relaxed) + elapsed, std::memory_order_relaxed);
+    if (elapsed > record.MaxTaskTime.load(std::memory_order_relaxed))
+        record.MaxTaskTime.store(elapsed, std::memory_order_relaxed);
+}
+
+std::vector<TaskActivityInfo> TaskActivity::get_all() {
+    std::vector<TaskActivityInfo> result;
+
+    get_registry().for_each([&](ActivityRecord& record) {
+        const u64 task = record.CurrentTask.load(std::memory_order_acquire);
+        std::type_info const* const origin = record.TaskOrigin.load(std::memory_order_relaxed);
+        const SteadyClock::rep started = record.TaskStarted.load(std::memory_order_relaxed);
+
+        result.push_back({record.Id,
+            record.Thread,
+            NativeThread::get_cpu_time(record.Native),
+            record.TasksCompleted.load(std::memory_order_relaxed),
+            to_duration(record.TotalTaskTime.load(std::memory_order_relaxed)),
+            to_duration(record.MaxTaskTime.load(std::memory_order_relaxed)),
+            task,
+            task ? to_duration(std::max<SteadyClock::rep>(get_now() - started, 0)) : Duration::zero(),
+            task && origin ? String(demangle(origin->name())) : String()});
+    });
+    return result;
+}
+
+void TaskActivity::enable_backtrace_capture() {
+    NativeThread::set_interrupt_handler(&capture_own_backtrace);
+}
+
+Optional<RawBacktrace> TaskActivity::capture_backtrace(u64 id, u64 task, Duration const& timeout) {
+    ActivityRegistry& registry = get_registry();
+    MutexLock l(registry.get_capture_mutex());
+
+    u64 request = 0;
+    const ActivityRecordPtr record = registry.find([&](ActivityRecord& record) {
+        if (record.Id != id || record.CurrentTask.load(std::memory_order_acquire) != task)
+            return false;
+
+        request = record.BacktraceRequested.load(std::memory_order_relaxed) + 1;
+        record.BacktraceRequested.store(request, std::memory_order_release);
+        return NativeThread::interrupt(record.Native);
+    });
+    if (!record)
+        return nullptr;
+
+    const auto deadline = SteadyClock::now() + timeout;
+    while (record->BacktraceCompleted.load(std::memory_order_acquire) != request && SteadyClock::now() < deadline)
+        Thread::sleep(Milliseconds(1));
+
+    if (record->BacktraceCompleted.load(std::memory_order_acquire) != request)
+        return nullptr;
+
+    uintptr_t frames[RawBacktrace::MaxDepth];
+    const size_t size = record->BacktraceSize.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < size; ++i)
+        frames[i] = record->BacktraceFrames[i].load(std::memory_order_relaxed);
+    return RawBacktrace(frames, size);
+}
+}
@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) Vladimir Golubev
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <gum/Optional.h>
+#include <gum/concurrency/ThreadInfo.h>
+#include <gum/diagnostics/Backtrace.h>
+#include <gum/time/Types.h>
+
+#include <typeinfo>
+#include <vector>
+
+namespace gum {
+
+struct TaskActivityInfo {
+    u64 Id;
+    ThreadInfoRef Thread;
+    Optional<Duration> CpuTime;
+
+    u64 TasksCompleted;
+    Duration TotalTaskTime;
+    Duration MaxTaskTime;
+
+    u64 CurrentTask;
+    Duration CurrentTaskElapsed;
+    String CurrentTaskOrigin;
+
+  public:
+    String to_string() const;
+};
+
+class TaskActivity {
+  public:
+    class Scope {
+      public:
+        explicit Scope(std::type_info const& origin);
+        ~Scope();
+
+        Scope(Scope const&) = delete;
+        Scope& operator=(Scope const&) = delete;
+    };
+
+  public:
+    static std::vector<TaskActivityInfo> get_all();
+
+    // Installs the interrupt signal handler; call it before capture_backtrace(), preferably early at startup
+    static void enable_backtrace_capture();
+    static Optional<RawBacktrace> capture_backtrace(u64 id, u64 task, Duration const& timeout);
+};
+}
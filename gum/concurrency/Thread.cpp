@@ -24,10 +24,22 @@
 #include <gum/concurrency/Thread.h>
 #include <gum/string/ToString.h>
 
+#if defined(GUM_HAS_PTHREAD_CPU_CLOCK)
+#include <gum/backend/posix/concurrency/NativeThread.h>
+#else
+#include <gum/backend/dummy/concurrency/NativeThread.h>
+#endif
+
 namespace gum {
 
 namespace {
 
+#if defined(GUM_HAS_PTHREAD_CPU_CLOCK)
+using NativeThread = posix::NativeThread;
+#else
+using NativeThread = dummy::NativeThread;
+#endif
+
 thread_local ThreadInfoRef t_thread_info = make_shared_ref<ThreadInfo>(ThreadId(), make_shared_ref<String>("__UndefinedThread"));
 }
 
@@ -45,6 +57,14 @@ ThreadInfoRef Thread::get_own_info() {
     return t_thread_info;
 }
 
+void Thread::set_own_placement(ThreadPlacement const& placement) {
+    placement.apply_to_current_thread();
+}
+
+Optional<Duration> Thread::get_own_cpu_time() {
+    return NativeThread::get_own_cpu_time();
+}
+
 void Thread::sleep(Duration const& duration) {
     std::this_thread::sleep_for(duration);
 }
@@ -57,6 +77,10 @@ ThreadInfo Thread::get_info() const {
     return ThreadInfo(_impl.get_id(), _name);
 }
 
+Optional<Duration> Thread::get_cpu_time() const {
+    return NativeThread::get_cpu_time(const_cast<Impl&>(_impl).native_handle());
+}
+
 String Thread::to_string() const {
     return String() << "Thread: " << get_info();
 }
@@ -68,7 +92,12 @@ void Thread::thread_func() {
 void Thread::_thread_func() {
     t_thread_info = make_shared_ref<ThreadInfo>(std::this_thread::get_id(), _name);
 
-    _logger.info() << get_own_info() << " spawned.";
+    if (_placement.empty())
+        _logger.info() << get_own_info() << " spawned.";
+    else {
+        _logger.info() << get_own_info() << " spawned, " << _placement << ".";
+        GUM_TRY_LEVEL("Could not apply thread placement", LogLevel::Warning, set_own_placement(_placement));
+    }
 
     GUM_TRY_LEVEL("Uncaught exception from client thread function", LogLevel::Error, _task(_cancellation_token));
 }
@@ -22,8 +22,10 @@
 
 #pragma once
 
+#include <gum/Optional.h>
 #include <gum/concurrency/CancellationToken.h>
 #include <gum/concurrency/ThreadInfo.h>
+#include <gum/concurrency/ThreadPlacement.h>
 #include <gum/log/Logger.h>
 #include <gum/time/Types.h>
 
@@ -43,6 +45,7 @@ class Thread {
 
     StringConstRef _name;
     TaskType _task;
+    ThreadPlacement _placement;
 
     CancellationToken _cancellation_token;
     Impl _impl;
@@ -54,6 +57,13 @@ class Thread {
         , _task(std::forward<Callable_>(callable))
         , _impl(&Self::thread_func, this) {}
 
+    template <typename String_, typename Callable_>
+    Thread(String_&& name, ThreadPlacement const& placement, Callable_&& callable)
+        : _name(make_shared_ref<String>(std::forward<String_>(name)))
+        , _task(std::forward<Callable_>(callable))
+        , _placement(placement)
+        , _impl(&Self::thread_func, this) {}
+
     Thread(Thread&&) = default;
     Thread& operator=(Thread&&) = default;
 
@@ -62,10 +72,15 @@ class Thread {
     static void set_own_name(gum::String const& name);
     static ThreadInfoRef get_own_info();
 
+    static void set_own_placement(ThreadPlacement const& placement);
+
+    static Optional<Duration> get_own_cpu_time();
+
     static void sleep(Duration const& duration);
     static void sleep(Duration const& duration, ICancellationHandle& handle);
 
     ThreadInfo get_info() const;
+    Optional<Duration> get_cpu_time() const;
 
     String to_string() const;
 
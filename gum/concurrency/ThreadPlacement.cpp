@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) Vladimir Golubev
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <gum/concurrency/ThreadPlacement.h>
+
+#include <gum/concurrency/CpuTopology.h>
+#include <gum/string/ToString.h>
+
+#if defined(GUM_HAS_SCHED_AFFINITY)
+#include <gum/backend/posix/concurrency/ThreadPlacement.h>
+#else
+#include <gum/backend/dummy/concurrency/ThreadPlacement.h>
+#endif
+
+namespace gum {
+
+namespace {
+
+#if defined(GUM_HAS_SCHED_AFFINITY)
+using ThreadPlacementImpl = posix::ThreadPlacement;
+#else
+using ThreadPlacementImpl = dummy::ThreadPlacement;
+#endif
+}
+
+ThreadPlacement ThreadPlacement::on_cpus(CpuSet const& cpus) {
+    GUM_CHECK(!cpus.empty(), ArgumentException("cpus", cpus));
+    return {cpus, nullptr};
+}
+
+ThreadPlacement ThreadPlacement::on_node(u32 node) {
+    CpuSet const cpus = CpuTopology::get().get_node_cpus(node);
+    GUM_CHECK(!cpus.empty(), ArgumentException("node", node));
+    return {cpus, node};
+}
+
+std::vector<ThreadPlacement> ThreadPlacement::round_robin(std::vector<CpuSet> const& cpu_sets, size_t count) {
+    GUM_CHECK(!cpu_sets.empty(), ArgumentException("cpu_sets", "empty"));
+
+    std::vector<ThreadPlacement> result;
+    result.reserve(count);
+    for (size_t i = 0; i < count; ++i)
+        result.push_back(on_cpus(cpu_sets[i % cpu_sets.size()]));
+    return result;
+}
+
+bool ThreadPlacement::empty() const {
+    return !Cpus && !MemoryNode;
+}
+
+void ThreadPlacement::apply_to_current_thread() const {
+    if (Cpus)
+        ThreadPlacementImpl::set_cpus(*Cpus);
+    if (MemoryNode)
+        ThreadPlacementImpl::set_memory_node(*MemoryNode);
+}
+
+String ThreadPlacement::to_string() const {
+    String result = "ThreadPlacement: ";
+    if (empty())
+        return result << "any";
+
+    if (Cpus)
+        result << "cpus " << *Cpus;
+    if (MemoryNode)
+        result << (Cpus ? ", " : "") << "memory node " << *MemoryNode;
+    return result;
+}
+}
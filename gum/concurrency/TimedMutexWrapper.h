@@ -22,20 +22,32 @@
 
 #pragma once
 
+#include <gum/concurrency/LockOrderValidator.h>
+#include <gum/concurrency/LockProfiler.h>
+#include <gum/concurrency/MutexLogger.h>
 #include <gum/concurrency/ThreadInfo.h>
-#include <gum/log/LoggerSingleton.h>
 #include <gum/string/ToString.h>
 #include <gum/time/ElapsedTime.h>
 
 namespace gum {
 
-GUM_LOGGER_SINGLETON(MutexLogger);
+template <typename TimedMutex_>
+void const* get_lock_site(TimedMutex_ const& mutex) {
+    return &mutex;
+}
+
+template <typename TimedMutex_>
+void forget_lock_site(TimedMutex_ const& mutex, LockProfileRecorder& profile) {
+    profile.forget(get_lock_site(mutex));
+    LockOrderValidator::on_destroyed(get_lock_site(mutex));
+}
 
 template <typename TimedMutex_>
 class TimedMutexWrapper {
     TimedMutex_ _impl;
 
     OwnerInfo _owner;
+    LockProfileRecorder _profile;
 
   public:
     TimedMutexWrapper() = default;
@@ -46,7 +58,47 @@ class TimedMutexWrapper {
     TimedMutexWrapper(TimedMutex_&& impl)
         : _impl(std::move(impl)) {}
 
+    ~TimedMutexWrapper() {
+        forget_lock_site(_impl, _profile);
+    }
+
     void lock() {
+        LockOrderValidator::on_acquiring(get_lock_site(_impl));
+
+        if (GUM_UNLIKELY(LockProfiler::is_enabled()))
+            _profile.lock(get_lock_site(_impl), [this] { return _impl.try_lock(); }, [this] { do_lock(); });
+        else
+            do_lock();
+
+        on_acquired();
+    }
+
+    bool try_lock() {
+        if (!_impl.try_lock())
+            return false;
+
+        on_acquired();
+        return true;
+    }
+
+    void unlock() {
+        LockOrderValidator::on_released(get_lock_site(_impl));
+        _profile.unlock(get_lock_site(_impl));
+        _impl.unlock();
+    }
+
+  private:
+    void on_acquired() {
+        _owner.acquire();
+        LockOrderValidator::on_acquired(get_lock_site(_impl));
+    }
+
+#if defined(GUM_CONCURRENCY_USES_UNTIMED_LOCKS)
+    void do_lock() {
+        _impl.lock();
+    }
+#else
+    void do_lock() {
         const Seconds Threshold = Seconds(3);
         const ElapsedTime elapsed;
 
@@ -54,12 +106,7 @@ class TimedMutexWrapper {
             MutexLogger::get().warning() << "Could not lock mutex " << &_impl << " owned by: " << _owner << " for " << elapsed.elapsed_to<Seconds>() << "."
                                          << " There is probably a deadlock.\nBacktrace: " << Backtrace();
         }
-
-        _owner.acquire();
-    }
-
-    void unlock() {
-        _impl.unlock();
     }
+#endif
 };
 }
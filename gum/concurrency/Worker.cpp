@@ -23,6 +23,9 @@
 #include <gum/concurrency/Worker.h>
 
 #include <gum/Try.h>
+#include <gum/async/CurrentTaskQueue.h>
+#include <gum/concurrency/TaskActivity.h>
+#include <gum/concurrency/DummyCancellationHandle.h>
 #include <gum/functional/Invoker.h>
 #include <gum/maybe/Maybe.h>
 
@@ -31,33 +34,46 @@ namespace gum {
 GUM_DEFINE_LOGGER(Worker);
 
 void Worker::push(Task&& task) {
-    MutexLock l(_mutex);
+    const PushResult result = _queue.push(wrap(std::move(task)), *DummyCancellationHandle());
+    GUM_CHECK(result != PushResult::Rejected, TaskQueueOverflowException(String() << _thread << ", limits: " << _queue.get_limits()));
+}
 
-    _queue.push_back([task = std::move(task)] { GUM_TRY_LEVEL("Uncaught exception in worker task", LogLevel::Error, task()); });
-    _condition_variable.broadcast();
+PushResult Worker::try_push(Task&& task) {
+    return _queue.try_push(wrap(std::move(task)));
 }
 
-void Worker::thread_func(ICancellationHandle& handle) {
-    while (maybe(pop(handle)).and_(Invoker()))
-        ;
+PushResult Worker::try_push(CoalescingKey key, Task&& task) {
+    return _queue.try_push(key, wrap(std::move(task)));
 }
 
-Optional<Worker::Task> Worker::pop(ICancellationHandle& handle) {
-    MutexLock l(_mutex);
+PushResult Worker::push(Task&& task, ICancellationHandle& handle) {
+    return _queue.push(wrap(std::move(task)), handle);
+}
 
-    if (!_queue.empty())
-        return do_pop();
+PushResult Worker::push(CoalescingKey key, Task&& task, ICancellationHandle& handle) {
+    return _queue.push(key, wrap(std::move(task)), handle);
+}
 
-    _condition_variable.wait(_mutex, [this] { return !_queue.empty(); }, handle);
-    if (!handle)
-        return nullptr;
+TaskQueueLimits Worker::get_limits() const {
+    return _queue.get_limits();
+}
 
-    return do_pop();
+size_t Worker::size() const {
+    return _queue.size();
+}
+
+void Worker::thread_func(ICancellationHandle& handle) {
+    const CurrentTaskQueue::Scope scope(*this);
+
+    while (maybe(_queue.pop(handle)).and_(Invoker()))
+        ;
 }
 
-Worker::Task Worker::do_pop() {
-    Task task = std::move(_queue.front());
-    _queue.pop_front();
-    return task;
+Worker::Task Worker::wrap(Task&& task) {
+    std::type_info const* const origin = &task.target_type();
+    return [origin, task = std::move(task)] {
+        const TaskActivity::Scope activity(*origin);
+        GUM_TRY_LEVEL("Uncaught exception in worker task", LogLevel::Error, task());
+    };
 }
 }
@@ -22,42 +22,48 @@
 
 #pragma once
 
-#include <gum/Optional.h>
-#include <gum/async/ITaskQueue.h>
-#include <gum/concurrency/ConditionVariable.h>
-#include <gum/concurrency/Mutex.h>
+#include <gum/async/IBoundedTaskQueue.h>
+#include <gum/async/TaskDeque.h>
 #include <gum/concurrency/Thread.h>
 #include <gum/functional/Types.h>
 
-#include <deque>
-
 namespace gum {
 
-class Worker : public virtual ITaskQueue {
+class Worker : public virtual IBoundedTaskQueue {
     using Self = Worker;
 
-    using Queue = std::deque<Task>;
-
   private:
     static Logger _logger;
 
-    Queue _queue;
-    Mutex _mutex;
-    ConditionVariable _condition_variable;
+    TaskDeque _queue;
 
     Thread _thread;
 
   public:
     template <typename String_>
-    Worker(String_&& name)
-        : _thread(std::forward<String_>(name), std::bind(&Self::thread_func, this, _1)) {}
+    Worker(String_&& name, TaskQueueLimits const& limits = TaskQueueLimits())
+        : _queue(limits)
+        , _thread(std::forward<String_>(name), std::bind(&Self::thread_func, this, _1)) {}
+
+    template <typename String_>
+    Worker(String_&& name, ThreadPlacement const& placement, TaskQueueLimits const& limits = TaskQueueLimits())
+        : _queue(limits)
+        , _thread(std::forward<String_>(name), placement, std::bind(&Self::thread_func, this, _1)) {}
 
     void push(Task&& task) override;
 
+    PushResult try_push(Task&& task) override;
+    PushResult try_push(CoalescingKey key, Task&& task) override;
+
+    PushResult push(Task&& task, ICancellationHandle& handle) override;
+    PushResult push(CoalescingKey key, Task&& task, ICancellationHandle& handle) override;
+
+    TaskQueueLimits get_limits() const override;
+    size_t size() const override;
+
   private:
     void thread_func(ICancellationHandle& handle);
 
-    Optional<Task> pop(ICancellationHandle& handle);
-    Task do_pop();
+    static Task wrap(Task&& task);
 };
 }
@@ -22,6 +22,9 @@
 
 #include <gum/diagnostics/Backtrace.h>
 
+#include <algorithm>
+#include <sstream>
+
 #if defined(GUM_USES_GNU_BACKEND)
 #include <gum/backend/gnu/diagnostics/Backtrace.h>
 #else
@@ -34,11 +37,37 @@ namespace {
 
 #if defined(GUM_USES_GNU_BACKEND)
 using BacktraceGetter = gnu::BacktraceGetter;
+using RawBacktraceGetter = gnu::RawBacktraceGetter;
 #else
 using BacktraceGetter = dummy::BacktraceGetter;
+using RawBacktraceGetter = dummy::RawBacktraceGetter;
 #endif
 }
 
 Backtrace::Backtrace()
     : _backtrace(BacktraceGetter()()) {}
+
+RawBacktrace::RawBacktrace()
+    : _size(RawBacktraceGetter()(_frames.data(), _frames.size())) {}
+
+RawBacktrace::RawBacktrace(uintptr_t const* frames, size_t size)
+    : _size(std::min(size, _frames.size())) {
+    std::copy_n(frames, _size, _frames.begin());
+}
+
+bool RawBacktrace::operator==(RawBacktrace const& other) const {
+    return std::equal(_frames.begin(), _frames.begin() + _size, other._frames.begin(), other._frames.begin() + other._size);
+}
+
+bool RawBacktrace::operator<(RawBacktrace const& other) const {
+    return std::lexicographical_compare(_frames.begin(), _frames.begin() + _size, other._frames.begin(), other._frames.begin() + other._size);
+}
+
+std::string RawBacktrace::to_string() const {
+    std::stringstream ss;
+    for (size_t i = 0; i < _size; ++i)
+        ss << std::hex << "0x" << _frames[i] << " ";
+
+    return ss.str();
+}
 }
@@ -22,6 +22,7 @@
 
 #pragma once
 
+#include <array>
 #include <string>
 
 namespace gum {
@@ -36,4 +37,26 @@ class Backtrace {
         return _backtrace;
     }
 };
+
+class RawBacktrace {
+  public:
+    static constexpr size_t MaxDepth = 32;
+
+  private:
+    std::array<uintptr_t, MaxDepth> _frames;
+    size_t _size;
+
+  public:
+    RawBacktrace();
+    RawBacktrace(uintptr_t const* frames, size_t size);
+
+    size_t get_size() const {
+        return _size;
+    }
+
+    bool operator==(RawBacktrace const& other) const;
+    bool operator<(RawBacktrace const& other) const;
+
+    std::string to_string() const;
+};
 }
@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) Vladimir Golubev
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <gum/Match.h>
+#include <gum/Optional.h>
+#include <gum/async/coroutine/Awaitables.h>
+#include <gum/io/async/IAsyncByteStream.h>
+
+#include <vector>
+
+namespace gum {
+
+// Reads are accumulated in an internal buffer, and the ConstByteData returned by a read points into it.
+// That data stays valid only until the next read is started on the same reader.
+class AsyncReader {
+    using ReadResult = asio::IAsyncReadable::ReadResult;
+    using Buffer = std::vector<u8>;
+
+    class ReadAwaiter {
+        AsyncReader& _reader;
+        Optional<u64> _size;
+
+      public:
+        ReadAwaiter(AsyncReader& reader, Optional<u64> const& size)
+            : _reader(reader)
+            , _size(size) {}
+
+        bool await_ready() const noexcept {
+            return false;
+        }
+
+        bool await_suspend(std::coroutine_handle<> coroutine) {
+            return _reader.start_read(coroutine, _size);
+        }
+
+        ReadResult await_resume() {
+            return _reader.take_result();
+        }
+    };
+
+  private:
+    asio::IAsyncReadableRef _readable;
+    ITaskQueueRef _resume_queue;
+
+    Buffer _buffer;
+    Optional<u64> _size;
+    Optional<ReadResult> _result;
+
+    std::atomic<bool> _reading;
+    std::coroutine_handle<> _coroutine;
+    detail::AwaitGate _gate;
+
+    Token _operation;
+    Token _connection;
+
+  public:
+    AsyncReader(asio::IAsyncReadableRef const& readable, ITaskQueueRef const& resume_queue)
+        : _readable(readable)
+        , _resume_queue(resume_queue)
+        , _reading(false) {
+        _connection = _readable->data_read().connect([this](ReadResult const& result) { on_data_read(result); });
+    }
+
+    AsyncReader(AsyncReader const&) = delete;
+    AsyncReader& operator=(AsyncReader const&) = delete;
+
+    ReadAwaiter read() {
+        return ReadAwaiter(*this, nullptr);
+    }
+
+    ReadAwaiter read(u64 size) {
+        GUM_CHECK(size, ArgumentException("size", size));
+        return ReadAwaiter(*this, size);
+    }
+
+  private:
+    bool start_read(std::coroutine_handle<> coroutine, Optional<u64> const& size) {
+        GUM_CHECK(!_reading, "Read is already in progress");
+
+        _buffer.clear();
+        _size = size;
+        _result.reset();
+        _coroutine = coroutine;
+        _gate.reset();
+
+        _reading = true;
+        _operation = _size ? _readable->read(*_size) : _readable->read();
+
+        return _gate.suspend();
+    }
+
+    ReadResult take_result() {
+        _operation.release();
+        return std::move(*_result);
+    }
+
+    void on_data_read(ReadResult const& result) {
+        if (!_reading)
+            return;
+
+        match(
+            result,
+            [this](ExceptionRef const& error) { complete(error); },
+            [this](Eof const& eof) { complete(_buffer.empty() ? ReadResult(eof) : ReadResult(get_data())); },
+            [this](ConstByteData const& data) {
+                _buffer.insert(_buffer.end(), data.begin(), data.end());
+                if (_size && _buffer.size() >= *_size)
+                    complete(get_data());
+            });
+    }
+
+    ConstByteData get_data() const {
+        return ConstByteData(_buffer.data(), _buffer.size());
+    }
+
+    void complete(ReadResult&& result) {
+        _result = std::move(result);
+        _reading = false;
+
+        if (_gate.complete())
+            detail::resume_on(*_resume_queue, _coroutine);
+    }
+};
+}
@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) Vladimir Golubev
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <gum/concurrency/Rcu.h>
+#include <gum/smartpointer/SharedPtr.h>
+
+#include <atomic>
+
+namespace gum {
+
+// Readers are protected by Rcu, so retired values are released once Rcu reclaims them. Without a reclaimer set,
+// Rcu::retire() reclaims inline, which keeps the number of pinned old values bounded.
+//
+// Only load() and borrow() are lock-free, once the calling thread has registered with Rcu on its first read.
+// store(), exchange() and compare_exchange() allocate a holder and retire the old one through Rcu::retire(),
+// which takes a mutex and may reclaim inline, so they are meant for infrequent updates.
+template <typename Value_>
+class AtomicSharedPtr {
+    struct Holder {
+        SharedPtr<Value_> Value;
+    };
+
+  private:
+    std::atomic<Holder*> _holder;
+
+  public:
+    AtomicSharedPtr(SharedPtr<Value_> const& value = nullptr)
+        : _holder(make_holder(value)) {}
+
+    ~AtomicSharedPtr() {
+        delete _holder.load(std::memory_order_relaxed);
+    }
+
+    AtomicSharedPtr(AtomicSharedPtr const&) = delete;
+    AtomicSharedPtr& operator=(AtomicSharedPtr const&) = delete;
+
+    SharedPtr<Value_> load() const {
+        const RcuReadLock l;
+        Holder* const holder = _holder.load(std::memory_order_acquire);
+        return holder ? holder->Value : nullptr;
+    }
+
+    // Valid until the caller's Rcu read-side critical section ends
+    Value_* borrow() const {
+        GUM_CHECK(Rcu::is_read_locked(), LogicError("AtomicSharedPtr::borrow called outside of a Rcu read-side critical section"));
+        Holder* const holder = _holder.load(std::memory_order_acquire);
+        return holder ? holder->Value.get() : nullptr;
+    }
+
+    void store(SharedPtr<Value_> const& value) {
+        retire(_holder.exchange(make_holder(value), std::memory_order_acq_rel));
+    }
+
+    SharedPtr<Value_> exchange(SharedPtr<Value_> const& value) {
+        Holder* const previous = _holder.exchange(make_holder(value), std::memory_order_acq_rel);
+        SharedPtr<Value_> result = previous ? previous->Value : nullptr;
+        retire(previous);
+        return result;
+    }
+
+    bool compare_exchange(SharedPtr<Value_>& expected, SharedPtr<Value_> const& desired) {
+        Holder* const replacement = make_holder(desired);
+
+        Holder* current;
+        {
+            const RcuReadLock l;
+            current = _holder.load(std::memory_order_acquire);
+            do {
+                if ((current ? current->Value.get() : nullptr) != expected.get()) {
+                    expected = current ? current->Value : nullptr;
+                    delete replacement;
+                    return false;
+                }
+            } while (!_holder.compare_exchange_weak(current, replacement, std::memory_order_acq_rel, std::memory_order_acquire));
+        }
+
+        // Retired outside of the read-side critical section, so an inline reclaim is not held back by this thread
+        retire(current);
+        return true;
+    }
+
+  private:
+    static Holder* make_holder(SharedPtr<Value_> const& value) {
+        return value ? new Holder{value} : nullptr;
+    }
+
+    static void retire(Holder* holder) {
+        if (holder)
+            Rcu::retire(holder);
+    }
+};
+}
@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) Vladimir Golubev
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <gum/smartpointer/AtomicSharedPtr.h>
+#include <gum/smartpointer/SharedReference.h>
+
+namespace gum {
+
+template <typename Value_>
+class AtomicSharedReference {
+    AtomicSharedPtr<Value_> _impl;
+
+  public:
+    explicit AtomicSharedReference(SharedReference<Value_> const& value)
+        : _impl(value) {}
+
+    SharedReference<Value_> load() const {
+        return _impl.load();
+    }
+
+    // Valid until the caller's Rcu read-side critical section ends
+    Value_& borrow() const {
+        return *_impl.borrow();
+    }
+
+    void store(SharedReference<Value_> const& value) {
+        _impl.store(value);
+    }
+
+    SharedReference<Value_> exchange(SharedReference<Value_> const& value) {
+        return _impl.exchange(value);
+    }
+
+    bool compare_exchange(SharedReference<Value_>& expected, SharedReference<Value_> const& desired) {
+        SharedPtr<Value_> expected_ptr = expected;
+        if (_impl.compare_exchange(expected_ptr, desired))
+            return true;
+
+        expected = expected_ptr;
+        return false;
+    }
+};
+}
@@ -0,0 +1,110 @@
+#include <gum/async/Actor.h>
+#include <gum/concurrency/DummyCancellationHandle.h>
+#include <gum/concurrency/ElasticThreadPool.h>
+#include <gum/concurrency/Latch.h>
+#include <gum/time/Types.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace gum;
+
+namespace {
+
+ElasticThreadPoolSettings make_settings() {
+    ElasticThreadPoolSettings settings;
+    settings.MaxThreads = 4;
+    return settings;
+}
+}
+
+class ActorTest : public ::testing::Test {
+  protected:
+    SharedReference<ElasticThreadPool> _pool;
+
+  public:
+    ActorTest()
+        : _pool(make_shared_ref<ElasticThreadPool>("actor_pool", make_settings())) {}
+
+    // Drain tasks keep the pool alive, so the last reference must not be dropped on a pool thread
+    void TearDown() override {
+        const auto deadline = SteadyClock::now() + Seconds(5);
+        while ((_pool->size() || _pool->get_idle_count() != _pool->get_thread_count()) && SteadyClock::now() < deadline)
+            std::this_thread::sleep_for(Milliseconds(5));
+        EXPECT_EQ(_pool->size(), 0u);
+    }
+};
+
+TEST_F(ActorTest, HandlerIsSerialized) {
+    Latch done(40000);
+    long balance = 0;
+    std::atomic<int> inside(0);
+    std::atomic<int> overlaps(0);
+
+    Actor<long> actor(_pool, [&](long& delta) {
+        if (inside++)
+            ++overlaps;
+        balance += delta;
+        --inside;
+        done.count_down();
+    });
+
+    std::vector<std::thread> senders;
+    for (int i = 0; i < 4; ++i)
+        senders.emplace_back([&] {
+            for (int j = 0; j < 10000; ++j)
+                actor.send(1);
+        });
+    for (auto& sender : senders)
+        sender.join();
+
+    EXPECT_TRUE(done.wait_for(Seconds(10), *DummyCancellationHandle()));
+    EXPECT_EQ(balance, 40000);
+    EXPECT_EQ(overlaps.load(), 0);
+}
+
+TEST_F(ActorTest, PreservesOrder) {
+    Latch done(1000);
+    std::vector<int> received;
+
+    Actor<int> actor(_pool, [&](int& value) {
+        received.push_back(value);
+        done.count_down();
+    }, 7);
+
+    for (int i = 0; i < 1000; ++i)
+        actor.send(i);
+
+    EXPECT_TRUE(done.wait_for(Seconds(10), *DummyCancellationHandle()));
+    ASSERT_EQ(received.size(), 1000u);
+    for (int i = 0; i < 1000; ++i)
+        EXPECT_EQ(received[i], i);
+}
+
+TEST_F(ActorTest, AddressOutlivesActor) {
+    std::atomic<int> handled(0);
+
+    Actor<int>::Address address;
+    {
+        Actor<int> actor(_pool, [&](int&) { ++handled; });
+        address = actor.get_address();
+        EXPECT_TRUE((bool)address);
+    }
+
+    address.send(1);
+    std::this_thread::sleep_for(Milliseconds(50));
+    EXPECT_EQ(handled.load(), 0);
+}
+
+TEST_F(ActorTest, DrainsAfterActorDestroyed) {
+    std::atomic<int> handled(0);
+    for (int round = 0; round < 100; ++round) {
+        auto actor = gum::make_unique<Actor<int>>(ITaskQueueRef(_pool), [&](int&) { ++handled; }, 1);
+        for (int i = 0; i < 100; ++i)
+            actor->send(i);
+    }
+    EXPECT_LE(handled.load(), 10000);
+}
@@ -0,0 +1,168 @@
+#include <gum/async/AsyncMutex.h>
+#include <gum/async/AsyncRwMutex.h>
+#include <gum/concurrency/CancellationToken.h>
+#include <gum/concurrency/DummyCancellationHandle.h>
+#include <gum/concurrency/ElasticThreadPool.h>
+#include <gum/concurrency/Latch.h>
+#include <gum/time/Types.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace gum;
+
+namespace {
+
+ElasticThreadPoolSettings make_settings(size_t threads) {
+    ElasticThreadPoolSettings settings;
+    settings.MinThreads = threads;
+    settings.MaxThreads = threads;
+    return settings;
+}
+}
+
+TEST(AsyncMutexTest, MutualExclusion) {
+    AsyncMutex mutex;
+    Latch done(2000);
+    std::atomic<int> inside(0);
+    std::atomic<int> violations(0);
+    int counter = 0;
+
+    ElasticThreadPool pool("async_mutex_pool", make_settings(2));
+    for (int i = 0; i < 2000; ++i)
+        pool.push([&] {
+            mutex.lock(pool, [&](AsyncMutexLock&& lock) {
+                EXPECT_TRUE((bool)lock);
+                if (++inside != 1)
+                    ++violations;
+                ++counter;
+                --inside;
+                lock.unlock();
+                done.count_down();
+            });
+        });
+
+    EXPECT_TRUE(done.wait(*DummyCancellationHandle()));
+    EXPECT_EQ(counter, 2000);
+    EXPECT_EQ(violations.load(), 0);
+    EXPECT_TRUE((bool)mutex.try_lock());
+}
+
+TEST(AsyncMutexTest, WaitersAreFifoAndCancellable) {
+    AsyncMutex mutex;
+    std::vector<int> order;
+    Latch done(4);
+    CancellationToken token;
+    DummyCancellationHandle dummy;
+
+    ElasticThreadPool pool("async_mutex_pool", make_settings(1));
+
+    AsyncMutexLock held = mutex.try_lock();
+    ASSERT_TRUE((bool)held);
+    EXPECT_FALSE((bool)mutex.try_lock());
+
+    for (int i = 0; i < 4; ++i) {
+        ICancellationHandle& handle = i == 2 ? static_cast<ICancellationHandle&>(token) : dummy;
+        mutex.lock(pool, [&, i](AsyncMutexLock lock) {
+            order.push_back(lock ? i : -i);
+            done.count_down();
+        }, handle);
+    }
+    EXPECT_EQ(mutex.get_waiters_count(), 4u);
+
+    token.cancel();
+    EXPECT_EQ(mutex.get_waiters_count(), 3u);
+
+    held.unlock();
+    EXPECT_TRUE(done.wait(*DummyCancellationHandle()));
+    EXPECT_EQ(order, std::vector<int>({-2, 0, 1, 3}));
+}
+
+TEST(AsyncMutexTest, AlreadyCancelledLock) {
+    AsyncMutex mutex;
+    Latch done(1);
+    bool acquired = true;
+    CancellationToken token;
+    token.cancel();
+
+    ElasticThreadPool pool("async_mutex_pool", make_settings(1));
+    const AsyncMutexLock held = mutex.try_lock();
+    mutex.lock(pool, [&](AsyncMutexLock lock) {
+        acquired = (bool)lock;
+        done.count_down();
+    }, token);
+
+    EXPECT_TRUE(done.wait(*DummyCancellationHandle()));
+    EXPECT_FALSE(acquired);
+    EXPECT_EQ(mutex.get_waiters_count(), 0u);
+}
+
+TEST(AsyncMutexTest, RwMutexWriterBlocksNewReaders) {
+    AsyncRwMutex mutex;
+    std::atomic<int> stage(0);
+    Latch done(2);
+
+    ElasticThreadPool pool("async_mutex_pool", make_settings(4));
+
+    AsyncMutexLock first_reader = mutex.try_lock_shared();
+    AsyncMutexLock second_reader = mutex.try_lock_shared();
+    EXPECT_TRUE(first_reader && second_reader);
+    EXPECT_FALSE((bool)mutex.try_lock());
+
+    mutex.lock(pool, [&](AsyncMutexLock lock) {
+        EXPECT_TRUE(lock.is_exclusive());
+        EXPECT_EQ(stage.exchange(1), 0);
+        done.count_down();
+    });
+    mutex.lock_shared(pool, [&](AsyncMutexLock) {
+        EXPECT_EQ(stage.load(), 1);
+        done.count_down();
+    });
+    EXPECT_FALSE((bool)mutex.try_lock_shared());
+
+    first_reader.unlock();
+    std::this_thread::sleep_for(Milliseconds(10));
+    EXPECT_EQ(stage.load(), 0);
+
+    second_reader = AsyncMutexLock();
+    EXPECT_TRUE(done.wait(*DummyCancellationHandle()));
+}
+
+TEST(AsyncMutexTest, RwMutexExclusion) {
+    AsyncRwMutex mutex;
+    std::atomic<int> readers(0);
+    std::atomic<int> writers(0);
+    std::atomic<int> violations(0);
+    Latch done(4000);
+
+    ElasticThreadPool pool("async_mutex_pool", make_settings(4));
+    for (int i = 0; i < 4000; ++i) {
+        const bool exclusive = i % 10 == 0;
+        pool.push([&, exclusive] {
+            const auto continuation = [&, exclusive](AsyncMutexLock) {
+                if (exclusive) {
+                    if (++writers != 1 || readers.load())
+                        ++violations;
+                    --writers;
+                } else {
+                    ++readers;
+                    if (writers.load())
+                        ++violations;
+                    --readers;
+                }
+                done.count_down();
+            };
+
+            if (exclusive)
+                mutex.lock(pool, continuation);
+            else
+                mutex.lock_shared(pool, continuation);
+        });
+    }
+
+    EXPECT_TRUE(done.wait(*DummyCancellationHandle()));
+    EXPECT_EQ(violations.load(), 0);
+}
@@ -0,0 +1,121 @@
+#include <gum/concurrency/Rcu.h>
+#include <gum/smartpointer/AtomicSharedPtr.h>
+#include <gum/smartpointer/AtomicSharedReference.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace gum;
+
+namespace {
+
+std::atomic<int> g_alive_configs(0);
+
+struct Config {
+    int Value;
+    int Negated;
+
+  public:
+    explicit Config(int value)
+        : Value(value)
+        , Negated(-value) {
+        ++g_alive_configs;
+    }
+
+    ~Config() {
+        Value = Negated = 12345;
+        --g_alive_configs;
+    }
+};
+}
+
+TEST(AtomicSharedPtrTest, LoadStoreExchange) {
+    AtomicSharedPtr<int> ptr;
+    EXPECT_FALSE((bool)ptr.load());
+
+    const auto one = make_shared_ref<int>(1);
+    ptr.store(one);
+    EXPECT_EQ(*ptr.load(), 1);
+
+    SharedPtr<int> expected;
+    EXPECT_FALSE(ptr.compare_exchange(expected, make_shared_ref<int>(2)));
+    EXPECT_EQ(expected.get(), one.get());
+    EXPECT_TRUE(ptr.compare_exchange(expected, make_shared_ref<int>(3)));
+
+    EXPECT_EQ(*ptr.exchange(nullptr), 3);
+    EXPECT_FALSE((bool)ptr.load());
+    EXPECT_ANY_THROW(ptr.borrow());
+
+    Rcu::synchronize();
+}
+
+TEST(AtomicSharedPtrTest, OldValuesAreReleasedWithoutReclaimer) {
+    Rcu::synchronize();
+    {
+        AtomicSharedReference<Config> config(make_shared_ref<Config>(0));
+        int peak = 0;
+        for (int i = 1; i < 10000; ++i) {
+            if (i % 2)
+                config.store(make_shared_ref<Config>(i));
+            else {
+                auto expected = config.load();
+                EXPECT_TRUE(config.compare_exchange(expected, make_shared_ref<Config>(i)));
+            }
+            peak = std::max(peak, g_alive_configs.load());
+        }
+        EXPECT_LT(peak, 1000);
+
+        Rcu::synchronize();
+        EXPECT_EQ(g_alive_configs.load(), 1);
+    }
+    EXPECT_EQ(g_alive_configs.load(), 0);
+}
+
+TEST(AtomicSharedPtrTest, ReadersNeverSeeReleasedValues) {
+    {
+        AtomicSharedReference<Config> config(make_shared_ref<Config>(0));
+        std::atomic<bool> stop(false);
+        std::atomic<long> torn(0);
+        std::atomic<long> reads(0);
+
+        std::vector<std::thread> readers;
+        for (int i = 0; i < 4; ++i)
+            readers.emplace_back([&] {
+                while (!stop) {
+                    {
+                        const auto loaded = config.load();
+                        if (loaded->Value != -loaded->Negated)
+                            ++torn;
+                    }
+                    {
+                        const RcuReadLock l;
+                        Config const& borrowed = config.borrow();
+                        if (borrowed.Value != -borrowed.Negated)
+                            ++torn;
+                    }
+                    ++reads;
+                }
+            });
+
+        while (!reads)
+            std::this_thread::yield();
+        for (int i = 1; i < 20000; ++i) {
+            config.store(make_shared_ref<Config>(i));
+            if (i % 100 == 0)
+                std::this_thread::yield();
+        }
+
+        stop = true;
+        for (auto& reader : readers)
+            reader.join();
+
+        EXPECT_EQ(torn.load(), 0);
+        EXPECT_GT(reads.load(), 0);
+        Rcu::synchronize();
+        EXPECT_EQ(g_alive_configs.load(), 1);
+    }
+    EXPECT_EQ(g_alive_configs.load(), 0);
+}
@@ -0,0 +1,169 @@
+#include <gum/concurrency/CancellationToken.h>
+#include <gum/concurrency/ConditionVariable.h>
+#include <gum/concurrency/Mutex.h>
+#include <gum/concurrency/ScopedCancellationCallback.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace gum;
+
+TEST(CancellationTokenTest, MultipleHandlers) {
+    CancellationToken token;
+    int first = 0;
+    int second = 0;
+    int third = 0;
+
+    const Token first_registration = token.on_cancelled([&] { ++first; });
+    Token second_registration = token.on_cancelled([&] { ++second; });
+    const Token third_registration = token.on_cancelled([&] { ++third; });
+    second_registration.release();
+
+    token.cancel();
+    token.cancel();
+    EXPECT_EQ(first, 1);
+    EXPECT_EQ(second, 0);
+    EXPECT_EQ(third, 1);
+
+    EXPECT_FALSE((bool)token.on_cancelled([&] { ++first; }));
+    EXPECT_EQ(first, 1);
+
+    token.reset();
+    EXPECT_TRUE((bool)token);
+}
+
+TEST(CancellationTokenTest, HandlerRemovesItself) {
+    CancellationToken token;
+    Token registration;
+    int fired = 0;
+    registration = token.on_cancelled([&] {
+        ++fired;
+        registration.release();
+    });
+
+    token.cancel();
+    EXPECT_EQ(fired, 1);
+}
+
+TEST(CancellationTokenTest, ParentCancelsChildren) {
+    CancellationToken root;
+    CancellationToken child = root.create_child();
+    CancellationToken grandchild = child.create_child();
+
+    int fired = 0;
+    const Token registration = grandchild.on_cancelled([&] { ++fired; });
+
+    std::atomic<int> scoped_fired(0);
+    {
+        auto handler = [&] { ++scoped_fired; };
+        ScopedCancellationCallback<decltype(handler)> callback(child, handler);
+        EXPECT_TRUE((bool)callback);
+    }
+
+    root.cancel();
+    EXPECT_FALSE((bool)child);
+    EXPECT_FALSE((bool)grandchild);
+    EXPECT_EQ(fired, 1);
+    EXPECT_EQ(scoped_fired.load(), 0);
+
+    EXPECT_FALSE((bool)root.create_child());
+}
+
+TEST(CancellationTokenTest, ChildDoesNotCancelParent) {
+    CancellationToken root;
+    CancellationToken child = root.create_child();
+
+    child.cancel();
+    EXPECT_FALSE((bool)child);
+    EXPECT_TRUE((bool)root);
+
+    {
+        CancellationToken short_lived = root.create_child();
+    }
+    root.cancel();
+}
+
+TEST(CancellationTokenTest, CancelWakesConditionVariableWaiters) {
+    CancellationToken token;
+    Mutex mutex;
+    ConditionVariable cv;
+    std::atomic<int> woken(0);
+
+    std::vector<std::thread> waiters;
+    for (int i = 0; i < 4; ++i)
+        waiters.emplace_back([&] {
+            MutexLock l(mutex);
+            cv.wait(mutex, [] { return false; }, token);
+            ++woken;
+        });
+
+    std::this_thread::sleep_for(Milliseconds(20));
+    EXPECT_EQ(woken.load(), 0);
+
+    token.cancel();
+    for (auto& waiter : waiters)
+        waiter.join();
+    EXPECT_EQ(woken.load(), 4);
+}
+
+TEST(CancellationTokenTest, SleepIsInterrupted) {
+    CancellationToken token;
+    const auto start = std::chrono::steady_clock::now();
+
+    std::thread canceller([&] {
+        std::this_thread::sleep_for(Milliseconds(20));
+        token.cancel();
+    });
+    token.sleep(Seconds(5));
+    canceller.join();
+    EXPECT_LT(std::chrono::steady_clock::now() - start, Seconds(2));
+
+    CancellationToken idle;
+    const auto idle_start = std::chrono::steady_clock::now();
+    idle.sleep(Milliseconds(20));
+    EXPECT_GE(std::chrono::steady_clock::now() - idle_start, Milliseconds(19));
+}
+
+TEST(CancellationTokenTest, RemoveWaitsForRunningHandler) {
+    for (int i = 0; i < 200; ++i) {
+        CancellationToken token;
+        std::atomic<int> inside(0);
+        Token registration = token.on_cancelled([&] {
+            ++inside;
+            std::this_thread::yield();
+            --inside;
+        });
+
+        std::thread canceller([&] { token.cancel(); });
+        registration.release();
+        EXPECT_EQ(inside.load(), 0);
+        canceller.join();
+    }
+}
+
+TEST(CancellationTokenTest, ScopedCallbackDestroyedWhileRunning) {
+    for (int i = 0; i < 100; ++i) {
+        CancellationToken token;
+        std::atomic<bool> started(false);
+        std::atomic<bool> finished(false);
+
+        std::thread canceller;
+        {
+            auto handler = [&] {
+                started = true;
+                std::this_thread::sleep_for(std::chrono::microseconds(200));
+                finished = true;
+            };
+            ScopedCancellationCallback<decltype(handler)> callback(token, handler);
+
+            canceller = std::thread([&] { token.cancel(); });
+            while (!started)
+                std::this_thread::yield();
+        }
+        EXPECT_TRUE(finished.load());
+        canceller.join();
+    }
+}
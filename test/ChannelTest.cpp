@@ -0,0 +1,236 @@
+#include <gum/concurrency/CancellationToken.h>
+#include <gum/concurrency/Channel.h>
+#include <gum/concurrency/DummyCancellationHandle.h>
+#include <gum/time/Types.h>
+
+#include <atomic>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace gum;
+
+namespace {
+
+class DelayedCancel {
+    CancellationToken& _token;
+    std::thread _thread;
+
+  public:
+    explicit DelayedCancel(CancellationToken& token)
+        : _token(token)
+        , _thread([this] {
+            std::this_thread::sleep_for(Milliseconds(20));
+            _token.cancel();
+        }) {}
+
+    ~DelayedCancel() {
+        _thread.join();
+    }
+};
+}
+
+TEST(ChannelTest, CapacityIsRoundedUp) {
+    EXPECT_EQ(Channel<int>(1).get_capacity(), 2u);
+    EXPECT_EQ(Channel<int>(2).get_capacity(), 2u);
+    EXPECT_EQ(SpscChannel<int>(100).get_capacity(), 128u);
+}
+
+TEST(ChannelTest, SpscPreservesOrder) {
+    const int count = 200000;
+    SpscChannel<std::unique_ptr<int>> channel(100);
+
+    std::thread producer([&] {
+        std::vector<std::unique_ptr<int>> batch;
+        for (int i = 0; i < count;) {
+            if (i % 3 == 0) {
+                batch.clear();
+                for (int j = 0; j < 10 && i + j < count; ++j)
+                    batch.emplace_back(new int(i + j));
+                EXPECT_TRUE(channel.send_batch(batch.begin(), batch.end(), *DummyCancellationHandle()));
+                i += batch.size();
+            } else
+                EXPECT_TRUE(channel.send(std::unique_ptr<int>(new int(i++)), *DummyCancellationHandle()));
+        }
+        channel.close();
+    });
+
+    int expected = 0;
+    int errors = 0;
+    std::vector<std::unique_ptr<int>> received;
+    for (;;) {
+        received.clear();
+        if (!channel.receive_batch(std::back_inserter(received), 7, *DummyCancellationHandle()))
+            break;
+        for (auto const& value : received)
+            if (*value != expected++)
+                ++errors;
+    }
+    producer.join();
+
+    EXPECT_EQ(expected, count);
+    EXPECT_EQ(errors, 0);
+}
+
+TEST(ChannelTest, MpmcDeliversEverything) {
+    const int producers = 4;
+    const int consumers = 4;
+    const int count = 50000;
+    Channel<int> channel(64);
+    std::atomic<long long> sum(0);
+    std::atomic<long long> received(0);
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < consumers; ++i)
+        threads.emplace_back([&] {
+            while (const auto value = channel.receive(*DummyCancellationHandle())) {
+                sum += *value;
+                ++received;
+            }
+        });
+
+    std::vector<std::thread> senders;
+    for (int i = 0; i < producers; ++i)
+        senders.emplace_back([&, i] {
+            for (int j = 0; j < count; ++j)
+                channel.send(i * count + j, *DummyCancellationHandle());
+        });
+    for (auto& sender : senders)
+        sender.join();
+
+    channel.close();
+    for (auto& thread : threads)
+        thread.join();
+
+    const long long total = (long long)producers * count;
+    EXPECT_EQ(received.load(), total);
+    EXPECT_EQ(sum.load(), total * (total - 1) / 2);
+}
+
+TEST(ChannelTest, SendAfterCloseFails) {
+    SpscChannel<std::unique_ptr<int>> channel(4);
+    EXPECT_TRUE(channel.try_send(std::unique_ptr<int>(new int(1))));
+    channel.close();
+    EXPECT_TRUE(channel.is_closed());
+
+    std::unique_ptr<int> value(new int(2));
+    EXPECT_FALSE(channel.try_send(std::move(value)));
+    EXPECT_FALSE(channel.send(std::unique_ptr<int>(new int(3)), *DummyCancellationHandle()));
+
+    std::vector<std::unique_ptr<int>> batch;
+    batch.emplace_back(new int(4));
+    EXPECT_TRUE(channel.try_send_batch(batch.begin(), batch.end()) == batch.begin());
+    ASSERT_TRUE((bool)batch[0]);
+    EXPECT_EQ(*batch[0], 4);
+
+    const auto first = channel.receive(*DummyCancellationHandle());
+    ASSERT_TRUE((bool)first);
+    EXPECT_EQ(**first, 1);
+    EXPECT_FALSE((bool)channel.receive(*DummyCancellationHandle()));
+}
+
+TEST(ChannelTest, CloseIsLinearizableWithSend) {
+    for (int round = 0; round < 200; ++round) {
+        Channel<int> channel(8);
+        std::atomic<long long> sent(0);
+        std::atomic<long long> received(0);
+
+        std::vector<std::thread> threads;
+        for (int i = 0; i < 3; ++i)
+            threads.emplace_back([&] {
+                while (channel.send(1, *DummyCancellationHandle()))
+                    ++sent;
+            });
+        for (int i = 0; i < 2; ++i)
+            threads.emplace_back([&] {
+                while (channel.receive(*DummyCancellationHandle()))
+                    ++received;
+            });
+
+        std::this_thread::sleep_for(std::chrono::microseconds(round % 10 * 50));
+        channel.close();
+        for (auto& thread : threads)
+            thread.join();
+
+        ASSERT_EQ(received.load(), sent.load());
+    }
+}
+
+TEST(ChannelTest, OperationsAreCancellable) {
+    Channel<int> channel(2);
+    {
+        CancellationToken token;
+        const DelayedCancel cancel(token);
+        EXPECT_FALSE((bool)channel.receive(token));
+    }
+
+    EXPECT_TRUE(channel.try_send(1));
+    EXPECT_TRUE(channel.try_send(2));
+    EXPECT_FALSE(channel.try_send(3));
+    {
+        CancellationToken token;
+        const DelayedCancel cancel(token);
+        EXPECT_FALSE(channel.send(3, token));
+    }
+}
+
+TEST(ChannelTest, SelectFiresReadyCase) {
+    Channel<int> numbers(4);
+    SpscChannel<std::string> strings(4);
+    Channel<int> out(2);
+    std::string received;
+
+    std::thread sender([&] {
+        std::this_thread::sleep_for(Milliseconds(20));
+        strings.send("hello", *DummyCancellationHandle());
+    });
+    auto fired = select(*DummyCancellationHandle(), on_receive(numbers, [](int) {}), on_receive(strings, [&](std::string&& value) { received = value; }));
+    sender.join();
+    ASSERT_TRUE((bool)fired);
+    EXPECT_EQ(*fired, 1u);
+    EXPECT_EQ(received, "hello");
+
+    bool sent = false;
+    fired = select(*DummyCancellationHandle(), on_receive(numbers, [](int) {}), on_send(out, 5, [&] { sent = true; }));
+    ASSERT_TRUE((bool)fired);
+    EXPECT_EQ(*fired, 1u);
+    EXPECT_TRUE(sent);
+
+    EXPECT_TRUE(out.try_send(6));
+    {
+        CancellationToken token;
+        const DelayedCancel cancel(token);
+        EXPECT_FALSE((bool)select(token, on_receive(numbers, [](int) {}), on_send(out, 7, [] {})));
+    }
+
+    numbers.close();
+    strings.close();
+    EXPECT_FALSE((bool)select(*DummyCancellationHandle(), on_receive(numbers, [](int) {}), on_receive(strings, [](std::string&&) {})));
+}
+
+TEST(ChannelTest, SelectDrainsClosedChannels) {
+    Channel<int> first(16);
+    Channel<int> second(16);
+    long long received = 0;
+
+    std::thread first_sender([&] {
+        for (int i = 0; i < 20000; ++i)
+            first.send(1, *DummyCancellationHandle());
+        first.close();
+    });
+    std::thread second_sender([&] {
+        for (int i = 0; i < 20000; ++i)
+            second.send(2, *DummyCancellationHandle());
+        second.close();
+    });
+
+    while (select(*DummyCancellationHandle(), on_receive(first, [&](int value) { received += value; }), on_receive(second, [&](int value) { received += value; })))
+        ;
+    first_sender.join();
+    second_sender.join();
+    EXPECT_EQ(received, 60000);
+}
@@ -0,0 +1,210 @@
+#ifdef GUM_USES_COROUTINES
+
+#include <gum/async/coroutine/Spawn.h>
+#include <gum/backend/boost/asio/AsyncSleep.h>
+#include <gum/backend/boost/asio/BoostIoWorker.h>
+#include <gum/concurrency/CancellationToken.h>
+#include <gum/concurrency/DummyCancellationHandle.h>
+#include <gum/concurrency/Latch.h>
+#include <gum/concurrency/Thread.h>
+#include <gum/concurrency/Worker.h>
+#include <gum/io/async/AsyncReader.h>
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace gum;
+
+namespace {
+
+void wait_idle(ITaskQueue& queue) {
+    const auto latch = make_shared_ref<Latch>(1);
+    queue.push([latch] { latch->count_down(); });
+    latch->wait(*DummyCancellationHandle());
+}
+
+Task<int> double_value(int value) {
+    co_return value * 2;
+}
+
+Task<int> throw_logic_error() {
+    GUM_THROW(LogicError("boom"));
+    co_return 0;
+}
+
+Task<String> await_chain() {
+    const int first = co_await double_value(10);
+    int second = co_await double_value(first);
+    try {
+        co_await throw_logic_error();
+    } catch (std::exception const&) {
+        ++second;
+    }
+    co_return String() << second;
+}
+
+Task<int> wait_cancelled(ICancellationHandle& handle, ITaskQueueRef queue) {
+    co_await cancelled(handle, queue);
+    co_return 1;
+}
+
+Task<Duration> sleep_twice(boost::asio::io_service& service, ICancellationHandle& handle) {
+    const auto start = std::chrono::steady_clock::now();
+    co_await asio::async_sleep(service, Milliseconds(30));
+    co_await asio::async_sleep(service, Seconds(10), handle);
+    co_return std::chrono::steady_clock::now() - start;
+}
+
+Task<Unit> sleep_cancellable(boost::asio::io_service& service, ICancellationHandle& handle) {
+    co_await asio::async_sleep(service, Seconds(10), handle);
+    co_return Unit();
+}
+
+class FakeReadable : public asio::IAsyncReadable {
+    Signal<DataReadSignature> _data_read;
+    ITaskQueueRef _queue;
+    std::vector<std::vector<u8>> _chunks;
+    size_t _next;
+
+  public:
+    FakeReadable(ITaskQueueRef const& queue, std::vector<std::vector<u8>> const& chunks)
+        : _queue(queue)
+        , _chunks(chunks)
+        , _next(0) {}
+
+    Token read() override {
+        _queue->push([this] {
+            while (_next < _chunks.size())
+                emit_next();
+            _data_read(ReadResult(Eof()));
+        });
+        return Token();
+    }
+
+    Token read(u64 size) override {
+        _queue->push([this, size] {
+            u64 received = 0;
+            while (received < size && _next < _chunks.size())
+                received += emit_next();
+            if (received < size)
+                _data_read(ReadResult(Eof()));
+        });
+        return Token();
+    }
+
+    SignalHandle<DataReadSignature> data_read() const override {
+        return _data_read.get_handle();
+    }
+
+  private:
+    size_t emit_next() {
+        const auto& chunk = _chunks[_next++];
+        _data_read(ReadResult(ConstByteData(chunk.data(), chunk.size())));
+        return chunk.size();
+    }
+};
+
+Task<String> read_all(asio::IAsyncReadableRef readable, ITaskQueueRef queue) {
+    AsyncReader reader(readable, queue);
+    String trace;
+
+    const auto sized = co_await reader.read(4);
+    trace << boost::get<ConstByteData>(sized).size() << ":";
+
+    const auto rest = co_await reader.read();
+    trace << boost::get<ConstByteData>(rest).size() << ":";
+
+    const auto eof = co_await reader.read();
+    trace << (boost::get<Eof>(&eof) ? "eof" : "data");
+    co_return trace;
+}
+}
+
+TEST(CoroutineTest, AwaitChainAndExceptions) {
+    const auto worker = make_shared_ref<Worker>("coroutine_worker");
+
+    auto chain = spawn(worker, await_chain());
+    EXPECT_EQ(boost::get<String>(chain.get(*DummyCancellationHandle())), "41");
+
+    auto failing = spawn(worker, throw_logic_error());
+    const auto failure = failing.get(*DummyCancellationHandle());
+    EXPECT_TRUE(boost::get<ExceptionRef>(&failure));
+
+    wait_idle(*worker);
+}
+
+TEST(CoroutineTest, FrameAllocatorRecyclesFrames) {
+    void* const frame = FrameAllocator::allocate(100);
+    FrameAllocator::deallocate(frame, 100);
+
+    void* const recycled = FrameAllocator::allocate(120);
+    EXPECT_EQ(frame, recycled);
+    FrameAllocator::deallocate(recycled, 120);
+
+    void* const large = FrameAllocator::allocate(100000);
+    FrameAllocator::deallocate(large, 100000);
+}
+
+TEST(CoroutineTest, AwaitCancellation) {
+    const auto worker = make_shared_ref<Worker>("coroutine_worker");
+    CancellationToken token;
+
+    auto waiting = spawn(worker, wait_cancelled(token, worker));
+    Thread::sleep(Milliseconds(20));
+    EXPECT_FALSE(waiting.is_ready());
+
+    token.cancel();
+    EXPECT_EQ(boost::get<int>(waiting.get(*DummyCancellationHandle())), 1);
+
+    auto already_cancelled = spawn(worker, wait_cancelled(token, worker));
+    EXPECT_EQ(boost::get<int>(already_cancelled.get(*DummyCancellationHandle())), 1);
+
+    wait_idle(*worker);
+}
+
+TEST(CoroutineTest, AsyncSleepIsCancellable) {
+    asio::BoostIoWorker io_worker("io_worker", 1);
+    const auto worker = make_shared_ref<Worker>("coroutine_worker");
+    CancellationToken token;
+
+    auto sleeping = spawn(worker, sleep_twice(*io_worker.get_service(), token));
+    Thread::sleep(Milliseconds(100));
+    EXPECT_FALSE(sleeping.is_ready());
+    token.cancel();
+
+    const Duration elapsed = boost::get<Duration>(sleeping.get(*DummyCancellationHandle()));
+    EXPECT_GE(elapsed, Milliseconds(30));
+    EXPECT_LT(elapsed, Seconds(2));
+
+    wait_idle(*worker);
+}
+
+TEST(CoroutineTest, AsyncSleepCancelRace) {
+    asio::BoostIoWorker io_worker("io_worker", 4);
+    const auto worker = make_shared_ref<Worker>("coroutine_worker");
+
+    for (int i = 0; i < 100; ++i) {
+        CancellationToken token;
+        auto sleeping = spawn(worker, sleep_cancellable(*io_worker.get_service(), token));
+        token.cancel();
+        const auto result = sleeping.get(*DummyCancellationHandle());
+        EXPECT_TRUE(boost::get<Unit>(&result));
+    }
+
+    wait_idle(*worker);
+}
+
+TEST(CoroutineTest, AsyncReader) {
+    const auto worker = make_shared_ref<Worker>("coroutine_worker");
+    const auto io_worker = make_shared_ref<Worker>("io_worker");
+    const auto readable = make_shared_ref<FakeReadable>(io_worker, std::vector<std::vector<u8>>{{1, 2}, {3, 4}, {5}, {6, 7, 8}});
+
+    auto reading = spawn(worker, read_all(readable, worker));
+    EXPECT_EQ(boost::get<String>(reading.get(*DummyCancellationHandle())), "4:4:eof");
+
+    wait_idle(*worker);
+    wait_idle(*io_worker);
+}
+
+#endif
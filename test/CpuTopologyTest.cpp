@@ -0,0 +1,97 @@
+#include <gum/concurrency/CpuTopology.h>
+#include <gum/concurrency/ThreadPlacement.h>
+#include <gum/concurrency/Worker.h>
+
+#include <cstdlib>
+#include <fstream>
+#include <future>
+#include <string>
+
+#include <sched.h>
+#include <sys/stat.h>
+
+#include <gtest/gtest.h>
+
+using namespace gum;
+
+namespace {
+
+const std::string FakeSysfsRoot = "__CpuTopologyTest.sysfs";
+
+void write_sysfs_file(std::string const& path, std::string const& content) {
+    for (size_t slash = path.find('/'); slash != std::string::npos; slash = path.find('/', slash + 1))
+        mkdir(path.substr(0, slash).c_str(), 0755);
+
+    std::ofstream os(path.c_str());
+    GUM_CHECK(os.is_open(), "Failed to open fake sysfs file");
+    os << content << "\n";
+}
+
+void make_fake_sysfs() {
+    std::system(("rm -rf " + FakeSysfsRoot).c_str());
+
+    write_sysfs_file(FakeSysfsRoot + "/cpu/online", "0-3");
+    for (int cpu = 0; cpu < 4; ++cpu) {
+        const std::string topology = FakeSysfsRoot + "/cpu/cpu" + std::to_string(cpu) + "/topology/";
+        write_sysfs_file(topology + "core_id", std::to_string(cpu % 2));
+        write_sysfs_file(topology + "physical_package_id", std::to_string(cpu / 2));
+    }
+
+    write_sysfs_file(FakeSysfsRoot + "/node/online", "0-1");
+    write_sysfs_file(FakeSysfsRoot + "/node/node0/cpulist", "0-1");
+    write_sysfs_file(FakeSysfsRoot + "/node/node1/cpulist", "2-3");
+}
+}
+
+TEST(CpuTopologyTest, ParseCpuList) {
+    EXPECT_EQ(CpuSet::parse("0-3,8,10-11\n"), CpuSet({0, 1, 2, 3, 8, 10, 11}));
+    EXPECT_EQ(CpuSet::parse("0-3,8,10-11").to_string(), String("0-3,8,10-11"));
+    EXPECT_EQ(String() << CpuSet({5}), String("5"));
+    EXPECT_TRUE(CpuSet::parse("").empty());
+
+    EXPECT_THROW(CpuSet::parse("a"), InvalidCpuListException);
+    EXPECT_THROW(CpuSet::parse("3-1"), InvalidCpuListException);
+}
+
+TEST(CpuTopologyTest, DiscoverFromSysfs) {
+    make_fake_sysfs();
+
+    const CpuTopology topology = CpuTopology::discover(FakeSysfsRoot.c_str());
+    EXPECT_EQ(topology.get_cpus().size(), 4u);
+    EXPECT_EQ(topology.get_nodes(), std::vector<u32>({0, 1}));
+    EXPECT_EQ(topology.get_node_cpus(1), CpuSet({2, 3}));
+    EXPECT_EQ(topology.get_physical_cores().size(), 4u);
+    EXPECT_EQ(topology.get_physical_cores(0u).size(), 2u);
+
+    std::system(("rm -rf " + FakeSysfsRoot).c_str());
+}
+
+TEST(CpuTopologyTest, MissingSysfsFallsBack) {
+    const CpuTopology topology = CpuTopology::discover("__CpuTopologyTest.nonexistent");
+    EXPECT_FALSE(topology.get_cpus().empty());
+    EXPECT_FALSE(CpuTopology::get().get_cpus().empty());
+}
+
+TEST(CpuTopologyTest, RoundRobinPlacement) {
+    const auto placements = ThreadPlacement::round_robin(CpuTopology::get().get_physical_cores(), 3);
+    EXPECT_EQ(placements.size(), 3u);
+}
+
+TEST(CpuTopologyTest, PinnedWorker) {
+    std::promise<bool> pinned;
+    {
+        Worker worker("pinned_worker", ThreadPlacement::on_cpus({0}));
+        worker.push([&] {
+            cpu_set_t cpus;
+            sched_getaffinity(0, sizeof(cpus), &cpus);
+            pinned.set_value(CPU_COUNT(&cpus) == 1 && CPU_ISSET(0, &cpus));
+        });
+        EXPECT_TRUE(pinned.get_future().get());
+    }
+    {
+        Worker worker("misplaced_worker", ThreadPlacement::on_cpus({1000}));
+        std::promise<void> ran;
+        worker.push([&] { ran.set_value(); });
+        ran.get_future().get();
+    }
+}
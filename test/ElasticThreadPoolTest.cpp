@@ -0,0 +1,110 @@
+#include <gum/concurrency/DummyCancellationHandle.h>
+#include <gum/concurrency/ElasticThreadPool.h>
+#include <gum/concurrency/Latch.h>
+#include <gum/concurrency/ManualResetEvent.h>
+
+#include <atomic>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+using namespace gum;
+
+namespace {
+
+template <typename Predicate_>
+bool eventually(Predicate_ const& predicate, Duration const& timeout = Seconds(5)) {
+    const auto deadline = SteadyClock::now() + timeout;
+    while (!predicate()) {
+        if (SteadyClock::now() >= deadline)
+            return false;
+        std::this_thread::sleep_for(Milliseconds(5));
+    }
+    return true;
+}
+
+ElasticThreadPoolSettings make_settings(size_t min_threads, size_t max_threads, Duration const& idle_timeout) {
+    ElasticThreadPoolSettings settings;
+    settings.MinThreads = min_threads;
+    settings.MaxThreads = max_threads;
+    settings.IdleTimeout = idle_timeout;
+    return settings;
+}
+}
+
+TEST(ElasticThreadPoolTest, GrowsAndRetires) {
+    ManualResetEvent release;
+    Latch started(4);
+    ElasticThreadPool pool("elastic_pool", make_settings(1, 4, Milliseconds(100)));
+    EXPECT_EQ(pool.get_thread_count(), 1u);
+
+    for (int i = 0; i < 4; ++i) {
+        pool.push([&] {
+            started.count_down();
+            release.wait(*DummyCancellationHandle());
+        });
+        std::this_thread::sleep_for(Milliseconds(5));
+        pool.push([] {});
+    }
+
+    EXPECT_TRUE(started.wait_for(Seconds(5), *DummyCancellationHandle()));
+    EXPECT_EQ(pool.get_thread_count(), 4u);
+
+    release.set();
+    EXPECT_TRUE(eventually([&] { return pool.get_thread_count() == 1; }));
+}
+
+TEST(ElasticThreadPoolTest, NeverExceedsMaxThreads) {
+    ManualResetEvent release;
+    std::atomic<int> started(0);
+    ElasticThreadPool pool("elastic_pool", make_settings(0, 2, Milliseconds(100)));
+
+    for (int i = 0; i < 6; ++i) {
+        pool.push([&] {
+            ++started;
+            release.wait(*DummyCancellationHandle());
+        });
+        std::this_thread::sleep_for(Milliseconds(5));
+        pool.push([] {});
+    }
+
+    EXPECT_TRUE(eventually([&] { return started.load() == 2; }));
+    std::this_thread::sleep_for(Milliseconds(50));
+    EXPECT_EQ(started.load(), 2);
+    EXPECT_LE(pool.get_thread_count(), 2u);
+
+    release.set();
+    EXPECT_TRUE(eventually([&] { return started.load() == 6; }));
+}
+
+TEST(ElasticThreadPoolTest, BlockingSectionCompensates) {
+    ManualResetEvent done;
+    ElasticThreadPool pool("elastic_pool", make_settings(1, 1, Milliseconds(100)));
+
+    pool.push([&] {
+        pool.push([&] { done.set(); });
+        ElasticThreadPool::BlockingSection blocking;
+        EXPECT_TRUE(done.wait_for(Seconds(5), *DummyCancellationHandle()));
+    });
+
+    EXPECT_TRUE(done.wait_for(Seconds(5), *DummyCancellationHandle()));
+    EXPECT_TRUE(eventually([&] { return pool.get_thread_count() == 1; }));
+}
+
+TEST(ElasticThreadPoolTest, RunsManyTasks) {
+    for (int round = 0; round < 5; ++round) {
+        std::atomic<int> counter(0);
+        Latch done(2000);
+        ElasticThreadPool pool("elastic_pool", make_settings(0, 8, Milliseconds(20)));
+
+        for (int i = 0; i < 2000; ++i)
+            pool.push([&] {
+                ++counter;
+                done.count_down();
+            });
+
+        EXPECT_TRUE(done.wait_for(Seconds(10), *DummyCancellationHandle()));
+        EXPECT_EQ(counter.load(), 2000);
+        std::this_thread::sleep_for(Milliseconds(round * 10));
+    }
+}
@@ -0,0 +1,154 @@
+#include <gum/async/fiber/Fiber.h>
+#include <gum/async/fiber/FiberConditionVariable.h>
+#include <gum/async/fiber/FiberMutex.h>
+#include <gum/concurrency/CancellationToken.h>
+#include <gum/concurrency/DummyCancellationHandle.h>
+#include <gum/concurrency/ElasticThreadPool.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace gum;
+
+namespace {
+
+ITaskQueueRef make_pool(size_t threads) {
+    ElasticThreadPoolSettings settings;
+    settings.MinThreads = threads;
+    settings.MaxThreads = threads;
+    return make_shared_ref<ElasticThreadPool>("fiber_pool", settings);
+}
+}
+
+TEST(FiberTest, MutexAndConditionVariable) {
+    FiberMutex mutex;
+    FiberConditionVariable changed;
+    long counter = 0;
+    int finished = 0;
+
+    FiberScheduler scheduler(make_pool(4));
+    std::vector<FiberRef> fibers;
+    for (int i = 0; i < 1000; ++i)
+        fibers.push_back(scheduler.spawn([&](ICancellationHandle&) {
+            for (int j = 0; j < 100; ++j) {
+                FiberMutexLock l(mutex);
+                ++counter;
+                if (j % 10 == 0)
+                    this_fiber::yield();
+            }
+
+            FiberMutexLock l(mutex);
+            ++finished;
+            changed.broadcast();
+        }));
+
+    const FiberRef waiter = scheduler.spawn([&](ICancellationHandle&) {
+        FiberMutexLock l(mutex);
+        changed.wait(mutex, [&] { return finished == 1000; }, *DummyCancellationHandle());
+    });
+
+    EXPECT_TRUE(waiter->join(*DummyCancellationHandle()));
+    for (auto const& fiber : fibers)
+        EXPECT_TRUE(fiber->join(*DummyCancellationHandle()));
+    EXPECT_EQ(counter, 100000);
+    EXPECT_EQ(scheduler.get_fiber_count(), 0u);
+}
+
+TEST(FiberTest, JoinFromFiberParks) {
+    std::atomic<bool> joined(false);
+
+    FiberScheduler scheduler(make_pool(1));
+    const FiberRef child = scheduler.spawn([](ICancellationHandle&) { this_fiber::sleep(Milliseconds(20), *DummyCancellationHandle()); });
+    const FiberRef parent = scheduler.spawn([&](ICancellationHandle&) { joined = child->join(*DummyCancellationHandle()); });
+
+    EXPECT_TRUE(parent->join(*DummyCancellationHandle()));
+    EXPECT_TRUE(joined.load());
+    EXPECT_TRUE(child->is_finished());
+}
+
+TEST(FiberTest, JoinFromFiberIsCancellable) {
+    CancellationToken release;
+    CancellationToken join_token;
+    std::atomic<bool> joined(true);
+
+    FiberScheduler scheduler(make_pool(1));
+    const FiberRef sleeper = scheduler.spawn([&](ICancellationHandle&) { this_fiber::sleep(Seconds(30), release); });
+    const FiberRef joiner = scheduler.spawn([&](ICancellationHandle&) { joined = sleeper->join(join_token); });
+
+    std::this_thread::sleep_for(Milliseconds(20));
+    EXPECT_FALSE(joiner->is_finished());
+    join_token.cancel();
+    EXPECT_TRUE(joiner->join(*DummyCancellationHandle()));
+    EXPECT_FALSE(joined.load());
+    EXPECT_FALSE(sleeper->is_finished());
+
+    release.cancel();
+    EXPECT_TRUE(sleeper->join(*DummyCancellationHandle()));
+}
+
+TEST(FiberTest, SleepAndCancel) {
+    std::atomic<int> slept(0);
+
+    FiberScheduler scheduler(make_pool(4));
+    std::vector<FiberRef> fibers;
+    const auto start = SteadyClock::now();
+    for (int i = 0; i < 10000; ++i)
+        fibers.push_back(scheduler.spawn([&](ICancellationHandle&) {
+            if (this_fiber::sleep(Milliseconds(50), *DummyCancellationHandle()))
+                ++slept;
+        }));
+    for (auto const& fiber : fibers)
+        fiber->join(*DummyCancellationHandle());
+    EXPECT_EQ(slept.load(), 10000);
+    EXPECT_LT(SteadyClock::now() - start, Seconds(3));
+
+    CancellationToken token;
+    bool result = true;
+    const FiberRef sleeper = scheduler.spawn([&](ICancellationHandle&) { result = this_fiber::sleep(Seconds(30), token); });
+    std::this_thread::sleep_for(Milliseconds(20));
+    token.cancel();
+    EXPECT_TRUE(sleeper->join(*DummyCancellationHandle()));
+    EXPECT_FALSE(result);
+
+    bool cancelled_result = true;
+    scheduler.spawn([&](ICancellationHandle&) { cancelled_result = this_fiber::sleep(Seconds(30), token); })->join(*DummyCancellationHandle());
+    EXPECT_FALSE(cancelled_result);
+}
+
+TEST(FiberTest, ConditionVariableWaitIsCancellable) {
+    FiberMutex mutex;
+    FiberConditionVariable changed;
+    CancellationToken token;
+    bool woken = false;
+
+    FiberScheduler scheduler(make_pool(2));
+    const FiberRef waiter = scheduler.spawn([&](ICancellationHandle&) {
+        FiberMutexLock l(mutex);
+        changed.wait(mutex, token);
+        woken = true;
+    });
+
+    std::this_thread::sleep_for(Milliseconds(20));
+    token.cancel();
+    EXPECT_TRUE(waiter->join(*DummyCancellationHandle()));
+    EXPECT_TRUE(woken);
+}
+
+TEST(FiberTest, ShutdownCancelsFibers) {
+    std::atomic<int> cancelled(0);
+    const auto start = SteadyClock::now();
+    {
+        FiberScheduler scheduler(make_pool(4));
+        for (int i = 0; i < 100; ++i)
+            scheduler.spawn([&](ICancellationHandle& handle) {
+                if (!this_fiber::sleep(Seconds(30), handle))
+                    ++cancelled;
+            });
+        std::this_thread::sleep_for(Milliseconds(20));
+    }
+    EXPECT_EQ(cancelled.load(), 100);
+    EXPECT_LT(SteadyClock::now() - start, Seconds(5));
+}
@@ -0,0 +1,170 @@
+#include <gum/async/Future.h>
+#include <gum/async/TaskQueue.h>
+#include <gum/concurrency/CancellationToken.h>
+#include <gum/concurrency/DummyCancellationHandle.h>
+#include <gum/concurrency/Latch.h>
+#include <gum/concurrency/Thread.h>
+#include <gum/concurrency/Worker.h>
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace gum;
+
+namespace {
+
+template <typename Exception_, typename Value_>
+bool holds_exception(ErrorOr<Value_> const& result) {
+    const ExceptionRef* const error = boost::get<ExceptionRef>(&result);
+    return error && dynamic_cast<Exception_ const*>(&**error);
+}
+
+template <typename Value_>
+bool holds_error_message(ErrorOr<Value_> const& result, String const& message) {
+    const ExceptionRef* const error = boost::get<ExceptionRef>(&result);
+    return error && std::string((*error)->what()).find(message.c_str()) != std::string::npos;
+}
+
+void wait_idle(ITaskQueue& queue) {
+    const auto latch = make_shared_ref<Latch>(1);
+    queue.push([latch] { latch->count_down(); });
+    latch->wait(*DummyCancellationHandle());
+}
+
+template <typename Value_>
+std::vector<Future<Value_>> get_futures(std::vector<Promise<Value_>>& promises) {
+    std::vector<Future<Value_>> futures;
+    for (auto& promise : promises)
+        futures.push_back(promise.get_future());
+    return futures;
+}
+}
+
+TEST(FutureTest, ThenChain) {
+    const auto worker = make_shared_ref<Worker>("future_worker");
+
+    Promise<int> promise;
+    auto future = promise.get_future()
+                      .then(worker, [](int value) { return value * 2; })
+                      .then(worker, [](int value) { return String() << value; })
+                      .then(worker, [](String const& value) { EXPECT_EQ(value, "42"); })
+                      .then(worker, [](Unit) { return make_ready_future<int>(5); })
+                      .then(worker, [](int value) { return value + 1; });
+
+    promise.set_value(21);
+    EXPECT_EQ(boost::get<int>(future.get(*DummyCancellationHandle())), 6);
+    wait_idle(*worker);
+}
+
+TEST(FutureTest, ExceptionSkipsThen) {
+    const auto worker = make_shared_ref<Worker>("future_worker");
+
+    Promise<int> promise;
+    auto future = promise.get_future()
+                      .then(worker, [](int value) -> int { GUM_THROW(LogicError(String() << "boom " << value)); })
+                      .then(worker, [](int value) {
+                          ADD_FAILURE() << "Continuation ran after an exception";
+                          return value;
+                      })
+                      .then_result(worker, [](ErrorOr<int>&& result) { return holds_exception<LogicError>(result) && holds_error_message(result, "boom 1") ? 7 : 0; });
+
+    promise.set_value(1);
+    EXPECT_EQ(boost::get<int>(future.get(*DummyCancellationHandle())), 7);
+    wait_idle(*worker);
+}
+
+TEST(FutureTest, ExceptionKeepsItsType) {
+    const auto worker = make_shared_ref<Worker>("future_worker");
+
+    Promise<int> promise;
+    auto future = promise.get_future().then(worker, [](int) -> int { throw std::out_of_range("out of range"); }).then(worker, [](int value) { return value; });
+
+    promise.set_value(1);
+    const auto result = future.get(*DummyCancellationHandle());
+    EXPECT_TRUE(holds_exception<std::out_of_range>(result));
+    EXPECT_TRUE(holds_error_message(result, "out of range"));
+    wait_idle(*worker);
+}
+
+TEST(FutureTest, ContinuationRunsInlineOnSameQueue) {
+    const auto queue = make_shared_ref<TaskQueue>();
+
+    Promise<int> promise;
+    int observed = 0;
+    auto future = promise.get_future().then(queue, [&](int value) { observed = value; });
+
+    queue->push([&] {
+        promise.set_value(3);
+        EXPECT_EQ(observed, 3);
+    });
+    queue->run();
+    EXPECT_TRUE(future.is_ready());
+}
+
+TEST(FutureTest, BrokenPromise) {
+    Future<int> future;
+    {
+        Promise<int> promise;
+        future = promise.get_future();
+    }
+    EXPECT_TRUE(holds_exception<BrokenPromiseException>(future.get(*DummyCancellationHandle())));
+}
+
+TEST(FutureTest, WhenAll) {
+    std::vector<Promise<int>> promises(3);
+    auto all = when_all(get_futures(promises));
+
+    promises[2].set_value(3);
+    promises[0].set_value(1);
+    EXPECT_FALSE(all.is_ready());
+    promises[1].set_value(2);
+
+    EXPECT_EQ(boost::get<std::vector<int>>(all.get(*DummyCancellationHandle())), (std::vector<int>{1, 2, 3}));
+}
+
+TEST(FutureTest, WhenAllPropagatesError) {
+    std::vector<Promise<int>> promises(2);
+    auto all = when_all(get_futures(promises));
+
+    promises[1].set_error(ExceptionRef(make_shared_ref<LogicError>("failed")));
+    EXPECT_TRUE(holds_exception<LogicError>(all.get(*DummyCancellationHandle())));
+}
+
+TEST(FutureTest, WhenAny) {
+    std::vector<Promise<int>> promises(3);
+    auto any = when_any(get_futures(promises));
+
+    promises[1].set_value(9);
+    const auto result = boost::get<std::pair<size_t, int>>(any.get(*DummyCancellationHandle()));
+    EXPECT_EQ(result.first, 1u);
+    EXPECT_EQ(result.second, 9);
+}
+
+TEST(FutureTest, CancelPropagatesUpstream) {
+    const auto worker = make_shared_ref<Worker>("future_worker");
+
+    Promise<int> promise;
+    CancellationToken token;
+    auto future = promise.get_future().then(worker, [](int value) { return value; });
+    const Token cancel_connection = future.cancel_on(token);
+
+    token.cancel();
+    EXPECT_TRUE(promise.is_cancelled());
+    EXPECT_TRUE(holds_exception<OperationCancelledException>(future.get(*DummyCancellationHandle())));
+    wait_idle(*worker);
+}
+
+TEST(FutureTest, GetIsCancellable) {
+    Promise<int> promise;
+    CancellationToken token;
+    auto future = promise.get_future();
+
+    Thread canceller("canceller", [&](ICancellationHandle&) {
+        Thread::sleep(Milliseconds(20));
+        token.cancel();
+    });
+    EXPECT_TRUE(holds_exception<OperationCancelledException>(future.get(token)));
+}
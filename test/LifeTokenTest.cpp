@@ -0,0 +1,116 @@
+#include <gum/concurrency/CancellableFunction.h>
+#include <gum/concurrency/LifeToken.h>
+#include <gum/time/Types.h>
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace gum;
+
+TEST(LifeTokenTest, ReleaseWaitsForRunningCalls) {
+    LifeToken token = LifeToken::make_synchronized();
+    std::atomic<int> calls(0);
+    std::atomic<bool> released(false);
+    std::atomic<bool> called_after_release(false);
+
+    const auto function = make_cancellable(
+        [&] {
+            std::this_thread::sleep_for(Milliseconds(2));
+            if (released)
+                called_after_release = true;
+            ++calls;
+        },
+        token.get_handle());
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; ++i)
+        threads.emplace_back([function] {
+            for (int j = 0; j < 50; ++j)
+                function();
+        });
+
+    std::this_thread::sleep_for(Milliseconds(20));
+    token.release();
+    released = true;
+    const int calls_at_release = calls;
+
+    for (auto& thread : threads)
+        thread.join();
+
+    EXPECT_FALSE(called_after_release.load());
+    EXPECT_EQ(calls.load(), calls_at_release);
+    EXPECT_GT(calls_at_release, 0);
+}
+
+TEST(LifeTokenTest, ConcurrentReleasesWaitForRunningCalls) {
+    LifeToken token = LifeToken::make_synchronized();
+    std::atomic<int> returned(0);
+
+    std::unique_ptr<LifeHandleLock> call(new LifeHandleLock(token.get_handle()));
+    ASSERT_TRUE((bool)*call);
+
+    std::vector<std::thread> releasers;
+    for (int i = 0; i < 2; ++i) {
+        releasers.emplace_back([&] {
+            token.release();
+            ++returned;
+        });
+        std::this_thread::sleep_for(Milliseconds(20));
+    }
+
+    EXPECT_EQ(returned.load(), 0);
+    call.reset();
+
+    for (auto& releaser : releasers)
+        releaser.join();
+    EXPECT_EQ(returned.load(), 2);
+}
+
+TEST(LifeTokenTest, ReleasedHandleDoesNotLock) {
+    LifeToken token = LifeToken::make_synchronized();
+    const LifeHandle handle = token.get_handle();
+    {
+        LifeHandleLock l(handle);
+        EXPECT_TRUE((bool)l);
+    }
+
+    token.release();
+    token.release();
+    {
+        LifeHandleLock l(handle);
+        EXPECT_FALSE((bool)l);
+    }
+}
+
+TEST(LifeTokenTest, NestedLocks) {
+    LifeToken token = LifeToken::make_synchronized();
+    const LifeHandle handle = token.get_handle();
+
+    LifeHandleLock outer(handle);
+    LifeHandleLock inner(handle);
+    EXPECT_TRUE((bool)outer);
+    EXPECT_TRUE((bool)inner);
+}
+
+TEST(LifeTokenTest, ReleasedToken) {
+    LifeToken token = LifeToken::make_released();
+    LifeHandleLock l(token.get_handle());
+    EXPECT_FALSE((bool)l);
+}
+
+TEST(LifeTokenTest, UnsynchronizedToken) {
+    LifeToken token = LifeToken::make_unsynchronized();
+    const LifeHandle handle = token.get_handle();
+    {
+        LifeHandleLock l(handle);
+        EXPECT_TRUE((bool)l);
+    }
+
+    token.release();
+    LifeHandleLock l(handle);
+    EXPECT_FALSE((bool)l);
+}
@@ -0,0 +1,130 @@
+#if defined(GUM_CONCURRENCY_VALIDATES_LOCK_ORDER)
+
+#include <gum/concurrency/LifeToken.h>
+#include <gum/concurrency/Mutex.h>
+#include <gum/concurrency/RwMutex.h>
+#include <gum/log/LoggerManager.h>
+
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+using namespace gum;
+
+namespace {
+
+class InversionCounter : public virtual ILoggerSink {
+    mutable std::mutex _mutex;
+    size_t _count;
+
+  public:
+    InversionCounter()
+        : _count(0) {}
+
+    void log(LogMessage const& message) override {
+        if (std::string(message.message.c_str()).find("Lock order inversion") == std::string::npos)
+            return;
+
+        std::lock_guard<std::mutex> l(_mutex);
+        ++_count;
+    }
+
+    size_t get_count() const {
+        std::lock_guard<std::mutex> l(_mutex);
+        return _count;
+    }
+};
+GUM_DECLARE_REF(InversionCounter);
+
+class LockOrderValidatorTest : public ::testing::Test {
+  protected:
+    InversionCounterRef _counter = make_shared_ref<InversionCounter>();
+    Token _sink = LoggerManager::get().register_logger_sink(_counter);
+};
+}
+
+TEST_F(LockOrderValidatorTest, ReportsInversionOnce) {
+    Mutex a, b;
+    std::thread([&] {
+        MutexLock la(a);
+        MutexLock lb(b);
+    }).join();
+    EXPECT_EQ(_counter->get_count(), 0u);
+
+    std::thread([&] {
+        MutexLock lb(b);
+        MutexLock la(a);
+    }).join();
+    EXPECT_EQ(_counter->get_count(), 1u);
+
+    std::thread([&] {
+        MutexLock lb(b);
+        MutexLock la(a);
+    }).join();
+    EXPECT_EQ(_counter->get_count(), 1u);
+}
+
+TEST_F(LockOrderValidatorTest, ConsistentOrderIsSilent) {
+    Mutex a, b, c;
+    for (int i = 0; i < 3; ++i) {
+        MutexLock la(a);
+        MutexLock lb(b);
+        MutexLock lc(c);
+    }
+    {
+        MutexLock la(a);
+        MutexLock lc(c);
+    }
+    EXPECT_EQ(_counter->get_count(), 0u);
+}
+
+TEST_F(LockOrderValidatorTest, RecursiveAndRwMutexes) {
+    RwMutex rw_mutex;
+    RecursiveMutex recursive_mutex;
+    Mutex mutex;
+    {
+        RecursiveMutexLock l1(recursive_mutex);
+        RecursiveMutexLock l2(recursive_mutex);
+        SharedMutexLock shared(rw_mutex.get_shared());
+        MutexLock l(mutex);
+    }
+    EXPECT_EQ(_counter->get_count(), 0u);
+    {
+        MutexLock l(mutex);
+        ExclusiveMutexLock exclusive(rw_mutex.get_exclusive());
+    }
+    EXPECT_EQ(_counter->get_count(), 1u);
+}
+
+TEST_F(LockOrderValidatorTest, DestroyedLocksAreForgotten) {
+    for (int i = 0; i < 4; ++i) {
+        Mutex a, b;
+        if (i % 2) {
+            MutexLock la(a);
+            MutexLock lb(b);
+        } else {
+            MutexLock lb(b);
+            MutexLock la(a);
+        }
+    }
+    EXPECT_EQ(_counter->get_count(), 0u);
+}
+
+TEST_F(LockOrderValidatorTest, LifeTokenRelease) {
+    Mutex mutex;
+    LifeToken token = LifeToken::make_synchronized();
+    {
+        LifeHandleLock l(token.get_handle());
+        MutexLock lm(mutex);
+    }
+    EXPECT_EQ(_counter->get_count(), 0u);
+    {
+        MutexLock lm(mutex);
+        token.release();
+    }
+    EXPECT_EQ(_counter->get_count(), 1u);
+}
+
+#endif
@@ -0,0 +1,111 @@
+#include <gum/concurrency/LockProfiler.h>
+#include <gum/concurrency/Mutex.h>
+#include <gum/concurrency/RwMutex.h>
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace gum;
+
+namespace {
+
+bool contains(String const& text, std::string const& fragment) {
+    return std::string(text.c_str()).find(fragment) != std::string::npos;
+}
+}
+
+TEST(LockProfilerTest, DisabledByDefault) {
+    LockProfiler::reset();
+    EXPECT_FALSE(LockProfiler::is_enabled());
+
+    Mutex mutex;
+    {
+        MutexLock l(mutex);
+    }
+    EXPECT_FALSE(contains(LockProfiler::get_report(), "acquisitions"));
+}
+
+TEST(LockProfilerTest, CountsAcquisitions) {
+    LockProfiler::reset();
+    LockProfiler::enable(1);
+
+    Mutex mutex;
+    RecursiveMutex recursive_mutex;
+    RwMutex rw_mutex;
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; ++i)
+        threads.emplace_back([&] {
+            for (int j = 0; j < 200; ++j) {
+                {
+                    MutexLock l(mutex);
+                    std::this_thread::sleep_for(std::chrono::microseconds(50));
+                }
+                {
+                    RecursiveMutexLock l(recursive_mutex);
+                }
+                {
+                    ExclusiveMutexLock l(rw_mutex.get_exclusive());
+                }
+            }
+        });
+    for (auto& thread : threads)
+        thread.join();
+
+    LockProfiler::disable();
+
+    const String report = LockProfiler::get_report();
+    EXPECT_TRUE(contains(report, "acquisitions: 800")) << report.c_str();
+    LockProfiler::reset();
+}
+
+TEST(LockProfilerTest, ForgetsDestroyedLocks) {
+    LockProfiler::reset();
+    LockProfiler::enable(1);
+
+    for (int i = 0; i < 3; ++i) {
+        Mutex mutex;
+        RwMutex rw_mutex;
+        MutexLock l(mutex);
+        ExclusiveMutexLock rw_l(rw_mutex.get_exclusive());
+    }
+
+    Mutex mutex;
+    {
+        MutexLock l(mutex);
+    }
+    LockProfiler::disable();
+
+    const String report = LockProfiler::get_report();
+    EXPECT_TRUE(contains(report, "acquisitions: 1,")) << report.c_str();
+    EXPECT_FALSE(contains(report, "acquisitions: 2")) << report.c_str();
+    EXPECT_FALSE(contains(report, "acquisitions: 3")) << report.c_str();
+    LockProfiler::reset();
+}
+
+TEST(LockProfilerTest, WriteReport) {
+    LockProfiler::reset();
+    LockProfiler::enable(1);
+
+    Mutex mutex;
+    {
+        MutexLock l(mutex);
+    }
+    LockProfiler::disable();
+
+    const String path = "__LockProfilerTest.report";
+    LockProfiler::write_report(path);
+
+    std::ifstream file(path.c_str());
+    ASSERT_TRUE(file.good());
+    const std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    EXPECT_NE(content.find("acquisitions: 1"), std::string::npos);
+
+    std::remove(path.c_str());
+    LockProfiler::reset();
+}
@@ -0,0 +1,93 @@
+#include <gum/backend/dummy/concurrency/Futex.h>
+#include <gum/concurrency/ConditionVariable.h>
+#include <gum/concurrency/DummyCancellationHandle.h>
+#include <gum/concurrency/Futex.h>
+#include <gum/concurrency/Mutex.h>
+
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace gum;
+
+TEST(MutexTest, MutualExclusion) {
+    Mutex mutex;
+    long counter = 0;
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 8; ++i)
+        threads.emplace_back([&] {
+            for (int j = 0; j < 100000; ++j) {
+                MutexLock l(mutex);
+                ++counter;
+            }
+        });
+    for (auto& thread : threads)
+        thread.join();
+
+    EXPECT_EQ(counter, 800000);
+}
+
+TEST(MutexTest, TryLock) {
+    Mutex mutex;
+    EXPECT_TRUE(mutex.try_lock());
+    std::thread([&] { EXPECT_FALSE(mutex.try_lock()); }).join();
+    mutex.unlock();
+    std::thread([&] {
+        EXPECT_TRUE(mutex.try_lock());
+        mutex.unlock();
+    }).join();
+}
+
+TEST(MutexTest, ConditionVariableWakesWaiter) {
+    Mutex mutex;
+    ConditionVariable cv;
+    bool ready = false;
+
+    std::thread notifier([&] {
+        std::this_thread::sleep_for(Milliseconds(10));
+        MutexLock l(mutex);
+        ready = true;
+        cv.broadcast();
+    });
+    {
+        MutexLock l(mutex);
+        cv.wait(mutex, [&] { return ready; }, *DummyCancellationHandle());
+    }
+    notifier.join();
+    EXPECT_TRUE(ready);
+}
+
+TEST(MutexTest, FutexWaitFor) {
+    Futex::Word word(0);
+
+    const auto start = std::chrono::steady_clock::now();
+    EXPECT_FALSE(Futex::wait_for(word, 0, Milliseconds(20)));
+    EXPECT_GE(std::chrono::steady_clock::now() - start, Milliseconds(19));
+
+    EXPECT_TRUE(Futex::wait_for(word, 1, Milliseconds(20)));
+
+    std::thread waker([&] {
+        std::this_thread::sleep_for(Milliseconds(10));
+        word = 1;
+        Futex::wake_all(word);
+    });
+    while (word.load() == 0)
+        Futex::wait(word, 0);
+    waker.join();
+}
+
+TEST(MutexTest, DummyFutexFallback) {
+    Futex::Word word(0);
+    EXPECT_FALSE(dummy::Futex::wait(word, 0, Duration(Milliseconds(20))));
+
+    std::thread waker([&] {
+        std::this_thread::sleep_for(Milliseconds(10));
+        word = 1;
+        dummy::Futex::wake(word, 1);
+    });
+    while (word.load() == 0)
+        dummy::Futex::wait(word, 0, nullptr);
+    waker.join();
+}
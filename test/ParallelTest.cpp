@@ -0,0 +1,117 @@
+#include <gum/async/Parallel.h>
+#include <gum/concurrency/DummyCancellationHandle.h>
+#include <gum/concurrency/Latch.h>
+#include <gum/concurrency/Worker.h>
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace gum;
+
+namespace {
+
+class RoundRobinExecutor : public virtual ITaskQueue {
+    std::vector<std::unique_ptr<Worker>> _workers;
+    std::atomic<size_t> _next;
+
+  public:
+    explicit RoundRobinExecutor(size_t concurrency)
+        : _next(0) {
+        for (size_t i = 0; i < concurrency; ++i)
+            _workers.emplace_back(new Worker("round_robin"));
+    }
+
+    void push(Task&& task) override {
+        _workers[_next++ % _workers.size()]->push(std::move(task));
+    }
+};
+
+ParallelOptions get_options() {
+    ParallelOptions options;
+    options.Concurrency = 4;
+    options.SerialCutoff = 100;
+    return options;
+}
+}
+
+TEST(ParallelTest, ForVisitsEachIndexOnce) {
+    RoundRobinExecutor executor(3);
+    std::vector<std::atomic<int>> hits(100000);
+
+    parallel_for(executor, range<size_t>(hits.size()), [&](size_t i) { ++hits[i]; }, get_options());
+
+    for (const auto& hit : hits)
+        ASSERT_EQ(hit.load(), 1);
+}
+
+TEST(ParallelTest, Reduce) {
+    RoundRobinExecutor executor(3);
+    std::vector<long> values(54321);
+    std::iota(values.begin(), values.end(), 1);
+
+    EXPECT_EQ(parallel_reduce(executor, Slice<long>(values), 0L, std::plus<long>(), get_options()), 54321L * 54322 / 2);
+    EXPECT_EQ(parallel_reduce(executor, range<long>(0, 100, 2), 0L, std::plus<long>(), [](long x) { return x * 2; }, get_options()), 2 * 2450L);
+    EXPECT_EQ(parallel_reduce(executor, range<int>(0), 7, std::plus<int>(), get_options()), 7);
+}
+
+TEST(ParallelTest, Transform) {
+    RoundRobinExecutor executor(3);
+    std::vector<long> values(54321);
+    std::iota(values.begin(), values.end(), 1);
+
+    std::vector<long> squares(values.size());
+    parallel_transform(executor, Slice<long>(values), squares.begin(), [](long x) { return x * x; }, get_options());
+
+    for (size_t i = 0; i < values.size(); ++i)
+        ASSERT_EQ(squares[i], values[i] * values[i]);
+}
+
+TEST(ParallelTest, Sort) {
+    RoundRobinExecutor executor(3);
+    std::mt19937 generator(1);
+    std::vector<int> values(77777);
+    for (auto& value : values)
+        value = int(generator());
+
+    auto expected = values;
+    std::sort(expected.begin(), expected.end());
+
+    parallel_sort(executor, values, std::less<int>(), get_options());
+    EXPECT_EQ(values, expected);
+
+    parallel_sort(executor, values.begin(), values.end(), std::greater<int>(), get_options());
+    EXPECT_TRUE(std::is_sorted(values.rbegin(), values.rend()));
+}
+
+TEST(ParallelTest, ExceptionPropagates) {
+    RoundRobinExecutor executor(3);
+    EXPECT_THROW(parallel_for(
+                     executor, range<int>(10000),
+                     [](int i) {
+                         if (i == 5000)
+                             throw std::runtime_error("failed");
+                     },
+                     get_options()),
+                 std::runtime_error);
+}
+
+TEST(ParallelTest, NestedOnSingleThreadDoesNotDeadlock) {
+    std::atomic<int> counter(0);
+    Latch done(1);
+    RoundRobinExecutor executor(1);
+
+    executor.push([&] {
+        parallel_for(executor, range<int>(5000), [&](int) { ++counter; }, get_options());
+        done.count_down();
+    });
+
+    done.wait(*DummyCancellationHandle());
+    EXPECT_EQ(counter.load(), 5000);
+}
@@ -0,0 +1,144 @@
+#include <gum/concurrency/RcuPtr.h>
+#include <gum/concurrency/Thread.h>
+#include <gum/concurrency/Worker.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace gum;
+
+namespace {
+
+std::atomic<int> g_live_configs(0);
+
+struct Config {
+    int First;
+    int Second;
+
+  public:
+    Config()
+        : First(0)
+        , Second(0) {
+        ++g_live_configs;
+    }
+
+    Config(Config const& other)
+        : First(other.First)
+        , Second(other.Second) {
+        ++g_live_configs;
+    }
+
+    ~Config() {
+        First = -1;
+        Second = -2;
+        --g_live_configs;
+    }
+};
+}
+
+TEST(RcuTest, ReadersNeverSeeReclaimedValues) {
+    {
+        RcuPtr<Config> config(make_unique<Config>());
+        std::atomic<bool> stop(false);
+        std::atomic<bool> violated(false);
+
+        std::vector<std::thread> readers;
+        for (int i = 0; i < 4; ++i)
+            readers.emplace_back([&] {
+                while (!stop) {
+                    RcuReadLock l;
+                    Config const* const current = config.get();
+                    const int first = current->First;
+                    std::this_thread::yield();
+                    if (current->Second != first || first < 0)
+                        violated = true;
+                }
+            });
+
+        for (int i = 1; i <= 2000; ++i)
+            config.update([i](Config& value) {
+                value.First = i;
+                value.Second = i;
+            });
+
+        stop = true;
+        for (auto& reader : readers)
+            reader.join();
+
+        EXPECT_FALSE(violated.load());
+        EXPECT_EQ(config.get()->First, 2000);
+
+        Rcu::synchronize();
+        EXPECT_EQ(g_live_configs.load(), 1);
+    }
+    EXPECT_EQ(g_live_configs.load(), 0);
+}
+
+TEST(RcuTest, GracePeriodWaitsForReaders) {
+    Rcu::synchronize();
+
+    std::atomic<bool> reclaimed(false);
+    {
+        RcuReadLock l;
+        EXPECT_TRUE(Rcu::is_read_locked());
+
+        Rcu::retire([&] { reclaimed = true; });
+        Rcu::reclaim();
+        EXPECT_FALSE(reclaimed.load());
+
+        std::thread([] { Rcu::reclaim(); }).join();
+        EXPECT_FALSE(reclaimed.load());
+
+        EXPECT_THROW(Rcu::synchronize(), LogicError);
+    }
+    EXPECT_FALSE(Rcu::is_read_locked());
+
+    Rcu::reclaim();
+    EXPECT_TRUE(reclaimed.load());
+}
+
+TEST(RcuTest, ReclaimsInlineWithoutReclaimer) {
+    Rcu::synchronize();
+
+    std::atomic<int> reclaimed(0);
+    for (int i = 0; i < 1000; ++i)
+        Rcu::retire([&] { ++reclaimed; });
+
+    EXPECT_GE(reclaimed.load(), 900);
+
+    Rcu::synchronize();
+    EXPECT_EQ(reclaimed.load(), 1000);
+}
+
+TEST(RcuTest, UpdatesDoNotAccumulate) {
+    Rcu::synchronize();
+    {
+        RcuPtr<Config> config(make_unique<Config>());
+        for (int i = 0; i < 10000; ++i)
+            config.update([i](Config& value) { value.First = i; });
+
+        EXPECT_LT(g_live_configs.load(), 200);
+    }
+    Rcu::synchronize();
+    EXPECT_EQ(g_live_configs.load(), 0);
+}
+
+TEST(RcuTest, BackgroundReclaimer) {
+    const auto worker = make_shared_ref<Worker>("rcu_reclaimer");
+    Token reclaimer = Rcu::set_reclaimer(worker);
+    EXPECT_THROW(Rcu::set_reclaimer(worker), LogicError);
+
+    std::atomic<bool> reclaimed(false);
+    Rcu::retire([&] { reclaimed = true; });
+
+    for (int i = 0; i < 1000 && !reclaimed; ++i) {
+        Rcu::retire([] {});
+        Thread::sleep(Milliseconds(5));
+    }
+    EXPECT_TRUE(reclaimed.load());
+
+    reclaimer.release();
+}
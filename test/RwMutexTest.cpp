@@ -0,0 +1,92 @@
+#include <gum/concurrency/RwMutex.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace gum;
+
+TEST(RwMutexTest, ReadersSeeConsistentState) {
+    RwMutex rw_mutex;
+    long first = 0;
+    long second = 0;
+    std::atomic<bool> violated(false);
+    std::atomic<int> writers_inside(0);
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 6; ++i)
+        threads.emplace_back([&] {
+            for (int j = 0; j < 50000; ++j) {
+                SharedMutexLock l(rw_mutex.get_shared());
+                if (first != second || writers_inside.load())
+                    violated = true;
+            }
+        });
+    for (int i = 0; i < 2; ++i)
+        threads.emplace_back([&] {
+            for (int j = 0; j < 2000; ++j) {
+                ExclusiveMutexLock l(rw_mutex.get_exclusive());
+                if (writers_inside.fetch_add(1))
+                    violated = true;
+                ++first;
+                ++second;
+                writers_inside.fetch_sub(1);
+            }
+        });
+    for (auto& thread : threads)
+        thread.join();
+
+    EXPECT_FALSE(violated.load());
+    EXPECT_EQ(first, 4000);
+}
+
+TEST(RwMutexTest, NestedSharedLocks) {
+    RwMutex rw_mutex;
+    RwMutex other_rw_mutex;
+    {
+        SharedMutexLock l1(rw_mutex.get_shared());
+        SharedMutexLock l2(rw_mutex.get_shared());
+        SharedMutexLock l3(other_rw_mutex.get_shared());
+
+        std::thread([&] {
+            EXPECT_FALSE(rw_mutex.get_exclusive().try_lock());
+            EXPECT_TRUE(other_rw_mutex.get_shared().try_lock());
+            other_rw_mutex.get_shared().unlock();
+        }).join();
+    }
+    EXPECT_TRUE(rw_mutex.get_exclusive().try_lock());
+    rw_mutex.get_exclusive().unlock();
+}
+
+TEST(RwMutexTest, ExclusiveBlocksShared) {
+    RwMutex rw_mutex;
+
+    EXPECT_TRUE(rw_mutex.get_exclusive().try_lock());
+    std::thread([&] { EXPECT_FALSE(rw_mutex.get_shared().try_lock()); }).join();
+    rw_mutex.get_exclusive().unlock();
+
+    std::thread([&] {
+        EXPECT_TRUE(rw_mutex.get_shared().try_lock());
+        rw_mutex.get_shared().unlock();
+    }).join();
+}
+
+TEST(RwMutexTest, WriterWaitsForReaders) {
+    RwMutex rw_mutex;
+    std::atomic<bool> written(false);
+
+    std::thread writer;
+    {
+        SharedMutexLock l(rw_mutex.get_shared());
+        writer = std::thread([&] {
+            ExclusiveMutexLock l(rw_mutex.get_exclusive());
+            written = true;
+        });
+        std::this_thread::sleep_for(Milliseconds(20));
+        EXPECT_FALSE(written.load());
+    }
+    writer.join();
+    EXPECT_TRUE(written.load());
+}
@@ -0,0 +1,72 @@
+#include <gum/concurrency/ShardedCounter.h>
+#include <gum/concurrency/ShardedMinMax.h>
+
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace gum;
+
+TEST(ShardedCounterTest, ShardCountIsRoundedUp) {
+    EXPECT_EQ(ShardedGauge(3).get_shard_count(), 4u);
+    EXPECT_EQ(ShardedCounter(1).get_shard_count(), 1u);
+    EXPECT_GE(ShardedCounter().get_shard_count(), 1u);
+}
+
+TEST(ShardedCounterTest, ConcurrentUpdates) {
+    ShardedCounter counter;
+    ShardedGauge gauge(3);
+    ShardedMinMax<s64> min_max(8);
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 16; ++i)
+        threads.emplace_back([&, i] {
+            for (int j = 0; j < 100000; ++j) {
+                counter.increment();
+                gauge.increment();
+                gauge.add(-2);
+                min_max.update(i * 1000 - j % 100);
+            }
+            counter.add(5);
+        });
+    for (auto& thread : threads)
+        thread.join();
+
+    EXPECT_EQ(counter.get(), 16u * 100000 + 16 * 5);
+    EXPECT_EQ(gauge.get(), -16 * 100000);
+    ASSERT_TRUE((bool)min_max.get_min());
+    EXPECT_EQ(*min_max.get_min(), -99);
+    EXPECT_EQ(*min_max.get_max(), 15000);
+}
+
+TEST(ShardedCounterTest, Reset) {
+    ShardedCounter counter;
+    counter.add(42);
+    ShardedGauge gauge;
+    gauge.decrement();
+    EXPECT_EQ(gauge.get(), -1);
+
+    counter.reset();
+    gauge.reset();
+    EXPECT_EQ(counter.get(), 0u);
+    EXPECT_EQ(gauge.get(), 0);
+}
+
+TEST(ShardedCounterTest, MinMaxIsEmptyUntilUpdated) {
+    ShardedMinMax<s64> min_max;
+    EXPECT_FALSE((bool)min_max.get_min());
+    EXPECT_FALSE((bool)min_max.get_max());
+
+    min_max.update(7);
+    EXPECT_EQ(*min_max.get_min(), 7);
+    EXPECT_EQ(*min_max.get_max(), 7);
+
+    min_max.reset();
+    EXPECT_FALSE((bool)min_max.get_min());
+
+    ShardedMinMax<double> doubles;
+    doubles.update(-1.5);
+    EXPECT_EQ(*doubles.get_min(), -1.5);
+    EXPECT_EQ(*doubles.get_max(), -1.5);
+}
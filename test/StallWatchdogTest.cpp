@@ -0,0 +1,140 @@
+#include <gum/concurrency/DummyCancellationHandle.h>
+#include <gum/concurrency/Latch.h>
+#include <gum/concurrency/StallWatchdog.h>
+#include <gum/concurrency/Worker.h>
+#include <gum/log/LoggerManager.h>
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace gum;
+
+namespace {
+
+void spin_for(Duration const& duration) {
+    const auto deadline = SteadyClock::now() + duration;
+    volatile u64 counter = 0;
+    while (SteadyClock::now() < deadline)
+        counter = counter + 1;
+}
+
+// Throttled hosts may give the thread much less CPU than wall-clock time, so spin by CPU time with a generous wall-clock cap
+Duration spin_for_cpu_time(Duration const& duration) {
+    const Duration start = *Thread::get_own_cpu_time();
+    const auto deadline = SteadyClock::now() + Seconds(10);
+    volatile u64 counter = 0;
+    Duration spent = Duration::zero();
+    while (spent < duration && SteadyClock::now() < deadline) {
+        counter = counter + 1;
+        spent = *Thread::get_own_cpu_time() - start;
+    }
+    return spent;
+}
+
+class StallReportCollector : public virtual ILoggerSink {
+    mutable std::mutex _mutex;
+    std::vector<std::string> _reports;
+
+  public:
+    void log(LogMessage const& message) override {
+        const std::string text = message.message.c_str();
+        if (text.find("Task stalled") == std::string::npos)
+            return;
+
+        std::lock_guard<std::mutex> l(_mutex);
+        _reports.push_back(text);
+    }
+
+    std::vector<std::string> get_reports() const {
+        std::lock_guard<std::mutex> l(_mutex);
+        return _reports;
+    }
+};
+GUM_DECLARE_REF(StallReportCollector);
+
+StallWatchdogSettings make_settings() {
+    StallWatchdogSettings settings;
+    settings.Threshold = Milliseconds(50);
+    settings.CheckInterval = Milliseconds(10);
+    settings.BacktraceTimeout = Seconds(1);
+    return settings;
+}
+}
+
+TEST(StallWatchdogTest, CpuTime) {
+    ASSERT_TRUE((bool)Thread::get_own_cpu_time());
+    EXPECT_GE(spin_for_cpu_time(Milliseconds(30)), Milliseconds(30));
+
+    Latch spun(1);
+    Thread thread("cpu_time_thread", [&](ICancellationHandle& handle) {
+        spin_for_cpu_time(Milliseconds(30));
+        spun.count_down();
+        handle.sleep(Seconds(10));
+    });
+    spun.wait(*DummyCancellationHandle());
+
+    const Optional<Duration> cpu_time = thread.get_cpu_time();
+    ASSERT_TRUE((bool)cpu_time);
+    EXPECT_GE(*cpu_time, Milliseconds(30));
+}
+
+TEST(StallWatchdogTest, ReportsStalledTaskOnce) {
+    const auto collector = make_shared_ref<StallReportCollector>();
+    const Token sink = LoggerManager::get().register_logger_sink(collector);
+
+    const StallWatchdog watchdog(make_settings());
+    Latch done(1);
+    Worker worker("stalling_worker");
+    worker.push([] { spin_for(Milliseconds(10)); });
+    worker.push([&] {
+        spin_for(Milliseconds(300));
+        done.count_down();
+    });
+    done.wait(*DummyCancellationHandle());
+    std::this_thread::sleep_for(Milliseconds(30));
+
+    EXPECT_EQ(watchdog.get_stalls_count(), 1u);
+    const std::vector<std::string> reports = collector->get_reports();
+    ASSERT_EQ(reports.size(), 1u);
+    EXPECT_NE(reports[0].find("stalling_worker"), std::string::npos) << reports[0];
+    EXPECT_NE(reports[0].find("backtrace: 0x"), std::string::npos) << reports[0];
+
+    bool found = false;
+    for (TaskActivityInfo const& info : TaskActivity::get_all())
+        found = found || (info.TasksCompleted >= 2 && info.MaxTaskTime >= Milliseconds(250));
+    EXPECT_TRUE(found);
+}
+
+TEST(StallWatchdogTest, CaptureBacktraceOfRunningTask) {
+    TaskActivity::enable_backtrace_capture();
+
+    std::atomic<bool> stop(false);
+    Latch started(1);
+    Worker worker("busy_worker");
+    worker.push([&] {
+        started.count_down();
+        while (!stop)
+            spin_for(Milliseconds(1));
+    });
+    started.wait(*DummyCancellationHandle());
+
+    Optional<TaskActivityInfo> busy;
+    for (TaskActivityInfo const& info : TaskActivity::get_all())
+        if (info.CurrentTask && std::string(info.Thread->to_string().c_str()).find("busy_worker") != std::string::npos)
+            busy = info;
+    ASSERT_TRUE((bool)busy);
+
+    for (int i = 0; i < 20; ++i) {
+        const Optional<RawBacktrace> backtrace = TaskActivity::capture_backtrace(busy->Id, busy->CurrentTask, Seconds(1));
+        ASSERT_TRUE((bool)backtrace);
+        EXPECT_GT(backtrace->get_size(), 1u);
+    }
+
+    EXPECT_FALSE((bool)TaskActivity::capture_backtrace(busy->Id, busy->CurrentTask + 1, Milliseconds(10)));
+    stop = true;
+}
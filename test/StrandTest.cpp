@@ -0,0 +1,111 @@
+#include <gum/async/KeyedExecutor.h>
+#include <gum/concurrency/Thread.h>
+#include <gum/concurrency/Worker.h>
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace gum;
+
+namespace {
+
+class RoundRobinExecutor : public virtual ITaskQueue {
+    std::vector<std::unique_ptr<Worker>> _workers;
+    std::atomic<size_t> _next;
+
+  public:
+    explicit RoundRobinExecutor(size_t concurrency)
+        : _next(0) {
+        for (size_t i = 0; i < concurrency; ++i)
+            _workers.emplace_back(new Worker("round_robin"));
+    }
+
+    void push(Task&& task) override {
+        _workers[_next++ % _workers.size()]->push(std::move(task));
+    }
+};
+
+void wait_for(std::atomic<int> const& counter, int value) {
+    while (counter.load() != value)
+        Thread::sleep(Milliseconds(1));
+}
+}
+
+TEST(StrandTest, TasksDoNotOverlap) {
+    const auto executor = make_shared_ref<RoundRobinExecutor>(4);
+    Strand strand(executor, 3);
+
+    std::atomic<int> inside(0);
+    std::atomic<int> overlaps(0);
+    std::atomic<int> done(0);
+    for (int i = 0; i < 5000; ++i)
+        strand.push([&] {
+            if (inside++ != 0)
+                ++overlaps;
+            --inside;
+            ++done;
+        });
+
+    wait_for(done, 5000);
+    EXPECT_EQ(overlaps.load(), 0);
+}
+
+TEST(StrandTest, PreservesOrder) {
+    const auto executor = make_shared_ref<RoundRobinExecutor>(4);
+    Strand strand(executor, 2);
+
+    std::vector<int> trace;
+    std::atomic<int> done(0);
+    for (int i = 0; i < 1000; ++i)
+        strand.push([&, i] {
+            trace.push_back(i);
+            ++done;
+        });
+
+    wait_for(done, 1000);
+    ASSERT_EQ(trace.size(), 1000u);
+    for (int i = 0; i < 1000; ++i)
+        EXPECT_EQ(trace[i], i);
+}
+
+TEST(StrandTest, KeyedExecutorPreservesPerKeyOrder) {
+    const int producers_count = 4;
+    const int tasks_per_producer = 2000;
+    const int keys_count = 8;
+
+    const auto executor = make_shared_ref<RoundRobinExecutor>(4);
+    std::vector<std::vector<int>> traces(keys_count);
+    std::atomic<int> done(0);
+    {
+        KeyedExecutor<int> keyed_executor(executor, 3, 5);
+        EXPECT_EQ(keyed_executor.get_shard_count(), 3u);
+
+        std::vector<Thread> producers;
+        producers.reserve(producers_count);
+        for (int producer = 0; producer < producers_count; ++producer)
+            producers.emplace_back("producer", [&, producer](ICancellationHandle&) {
+                for (int i = 0; i < tasks_per_producer; ++i) {
+                    const int key = (i + producer) % keys_count;
+                    keyed_executor.push(key, [&, key, producer, i] {
+                        traces[key].push_back(producer * tasks_per_producer + i);
+                        ++done;
+                    });
+                }
+            });
+        producers.clear();
+
+        wait_for(done, producers_count * tasks_per_producer);
+    }
+
+    for (const auto& trace : traces) {
+        std::vector<int> last(producers_count, -1);
+        for (int value : trace) {
+            const int producer = value / tasks_per_producer;
+            EXPECT_LT(last[producer], value % tasks_per_producer);
+            last[producer] = value % tasks_per_producer;
+        }
+    }
+}
@@ -0,0 +1,254 @@
+#include <gum/concurrency/AutoResetEvent.h>
+#include <gum/concurrency/Barrier.h>
+#include <gum/concurrency/CancellationToken.h>
+#include <gum/concurrency/ConditionVariable.h>
+#include <gum/concurrency/DummyCancellationHandle.h>
+#include <gum/concurrency/FutexConditionVariable.h>
+#include <gum/concurrency/Latch.h>
+#include <gum/concurrency/ManualResetEvent.h>
+#include <gum/concurrency/Semaphore.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace gum;
+
+TEST(SynchronizationPrimitivesTest, ManualResetEvent) {
+    ManualResetEvent event;
+    EXPECT_FALSE(event.wait_for(Milliseconds(10), *DummyCancellationHandle()));
+
+    std::thread setter([&] {
+        std::this_thread::sleep_for(Milliseconds(10));
+        event.set();
+    });
+    EXPECT_TRUE(event.wait(*DummyCancellationHandle()));
+    EXPECT_TRUE(event.wait(*DummyCancellationHandle()));
+    setter.join();
+
+    event.reset();
+    EXPECT_FALSE(event.is_set());
+}
+
+TEST(SynchronizationPrimitivesTest, AutoResetEventWakesOneWaiter) {
+    AutoResetEvent event;
+    std::atomic<int> woken(0);
+
+    std::vector<std::thread> waiters;
+    for (int i = 0; i < 3; ++i)
+        waiters.emplace_back([&] {
+            event.wait(*DummyCancellationHandle());
+            ++woken;
+        });
+
+    for (int i = 0; i < 3; ++i) {
+        std::this_thread::sleep_for(Milliseconds(5));
+        event.set();
+        while (woken.load() != i + 1)
+            std::this_thread::yield();
+    }
+    for (auto& waiter : waiters)
+        waiter.join();
+
+    EXPECT_FALSE(event.try_wait());
+}
+
+TEST(SynchronizationPrimitivesTest, CancellationWakesWaiters) {
+    CancellationToken token;
+    ManualResetEvent event;
+    Semaphore semaphore;
+    Latch latch(1);
+    std::atomic<int> cancelled(0);
+
+    std::vector<std::thread> waiters;
+    waiters.emplace_back([&] {
+        if (!event.wait(token))
+            ++cancelled;
+    });
+    waiters.emplace_back([&] {
+        if (!semaphore.acquire(token))
+            ++cancelled;
+    });
+    waiters.emplace_back([&] {
+        if (!latch.wait(token))
+            ++cancelled;
+    });
+    waiters.emplace_back([&] {
+        Mutex mutex;
+        FutexConditionVariable cv;
+        MutexLock l(mutex);
+        cv.wait(mutex, [] { return false; }, token);
+        ++cancelled;
+    });
+    waiters.emplace_back([&] {
+        Mutex mutex;
+        ConditionVariable cv;
+        MutexLock l(mutex);
+        cv.wait(mutex, [] { return false; }, token);
+        ++cancelled;
+    });
+
+    std::this_thread::sleep_for(Milliseconds(20));
+    EXPECT_EQ(cancelled.load(), 0);
+
+    token.cancel();
+    for (auto& waiter : waiters)
+        waiter.join();
+    EXPECT_EQ(cancelled.load(), 5);
+}
+
+TEST(SynchronizationPrimitivesTest, ConditionVariableCancelDoesNotWaitForMutex) {
+    CancellationToken token;
+    Mutex mutex;
+    ConditionVariable cv;
+    std::atomic<bool> waiting(false);
+
+    std::thread waiter([&] {
+        MutexLock l(mutex);
+        waiting = true;
+        cv.wait(mutex, [] { return false; }, token);
+    });
+    while (!waiting)
+        std::this_thread::yield();
+
+    std::atomic<bool> holding(false);
+    std::thread holder([&] {
+        MutexLock l(mutex);
+        holding = true;
+        std::this_thread::sleep_for(Milliseconds(300));
+    });
+    while (!holding)
+        std::this_thread::yield();
+
+    const auto start = std::chrono::steady_clock::now();
+    token.cancel();
+    EXPECT_LT(std::chrono::steady_clock::now() - start, Milliseconds(200));
+
+    holder.join();
+    waiter.join();
+}
+
+TEST(SynchronizationPrimitivesTest, SemaphoreLimitsConcurrency) {
+    Semaphore semaphore(2);
+    std::atomic<int> inside(0);
+    std::atomic<int> max_inside(0);
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 8; ++i)
+        threads.emplace_back([&] {
+            for (int j = 0; j < 50; ++j) {
+                semaphore.acquire(*DummyCancellationHandle());
+                const int current = ++inside;
+                int observed = max_inside;
+                while (current > observed && !max_inside.compare_exchange_weak(observed, current))
+                    ;
+                --inside;
+                semaphore.release();
+            }
+        });
+    for (auto& thread : threads)
+        thread.join();
+
+    EXPECT_LE(max_inside.load(), 2);
+    EXPECT_EQ(semaphore.get_count(), 2u);
+}
+
+TEST(SynchronizationPrimitivesTest, LatchAndBarrier) {
+    const int thread_count = 8;
+    const int phase_count = 20;
+
+    Latch done(thread_count);
+    Barrier barrier(thread_count);
+    std::atomic<int> arrivals(0);
+    std::atomic<int> phase_errors(0);
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < thread_count; ++i)
+        threads.emplace_back([&] {
+            for (int phase = 0; phase < phase_count; ++phase) {
+                ++arrivals;
+                barrier.arrive_and_wait(*DummyCancellationHandle());
+                if (arrivals.load() < (phase + 1) * thread_count)
+                    ++phase_errors;
+                barrier.arrive_and_wait(*DummyCancellationHandle());
+            }
+            done.count_down();
+        });
+
+    EXPECT_TRUE(done.wait(*DummyCancellationHandle()));
+    for (auto& thread : threads)
+        thread.join();
+
+    EXPECT_EQ(phase_errors.load(), 0);
+}
+
+TEST(SynchronizationPrimitivesTest, ConcurrentCountChecks) {
+    const int thread_count = 8;
+    Latch latch(thread_count / 2);
+    Semaphore semaphore(Semaphore::MaxCount - thread_count / 2);
+    std::atomic<int> counted_down(0);
+    std::atomic<int> released(0);
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < thread_count; ++i)
+        threads.emplace_back([&] {
+            try {
+                latch.count_down();
+                ++counted_down;
+            } catch (LogicError const&) {
+            }
+
+            try {
+                semaphore.release();
+                ++released;
+            } catch (LogicError const&) {
+            }
+        });
+    for (auto& thread : threads)
+        thread.join();
+
+    EXPECT_EQ(counted_down.load(), thread_count / 2);
+    EXPECT_TRUE(latch.try_wait());
+    EXPECT_EQ(released.load(), thread_count / 2);
+    EXPECT_EQ(semaphore.get_count(), (u32)Semaphore::MaxCount);
+}
+
+TEST(SynchronizationPrimitivesTest, FutexConditionVariablePingPong) {
+    Mutex mutex;
+    FutexConditionVariable cv;
+    int produced = 0;
+    int consumed = 0;
+
+    std::thread consumer([&] {
+        MutexLock l(mutex);
+        while (consumed < 1000) {
+            cv.wait(mutex, [&] { return produced > consumed; }, *DummyCancellationHandle());
+            consumed = produced;
+            cv.broadcast();
+        }
+    });
+    for (int i = 0; i < 1000; ++i) {
+        MutexLock l(mutex);
+        cv.wait(mutex, [&] { return produced == consumed; }, *DummyCancellationHandle());
+        ++produced;
+        cv.signal();
+    }
+    consumer.join();
+    EXPECT_EQ(consumed, 1000);
+
+    MutexLock l(mutex);
+    EXPECT_EQ(cv.wait_for(mutex, Milliseconds(10), *DummyCancellationHandle()), FutexConditionVariable::WaitResult::TimedOut);
+    EXPECT_FALSE(cv.wait_for(mutex, Milliseconds(10), [] { return false; }, *DummyCancellationHandle()));
+}
+
+TEST(SynchronizationPrimitivesTest, ConditionVariableTimedWait) {
+    Mutex mutex;
+    ConditionVariable cv;
+    MutexLock l(mutex);
+
+    EXPECT_EQ(cv.wait_for(mutex, Milliseconds(10), *DummyCancellationHandle()), ConditionVariable::WaitResult::TimedOut);
+    EXPECT_FALSE(cv.wait_for(mutex, Milliseconds(10), [] { return false; }, *DummyCancellationHandle()));
+    EXPECT_TRUE(cv.wait_for(mutex, Milliseconds(10), [] { return true; }, *DummyCancellationHandle()));
+}
@@ -0,0 +1,173 @@
+#include <gum/async/TaskGraph.h>
+#include <gum/concurrency/CancellationToken.h>
+#include <gum/concurrency/DummyCancellationHandle.h>
+#include <gum/concurrency/Latch.h>
+#include <gum/concurrency/Worker.h>
+
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace gum;
+
+namespace {
+
+class RoundRobinExecutor : public virtual ITaskQueue {
+    std::vector<std::unique_ptr<Worker>> _workers;
+    std::atomic<size_t> _next;
+
+  public:
+    explicit RoundRobinExecutor(size_t concurrency)
+        : _next(0) {
+        for (size_t i = 0; i < concurrency; ++i)
+            _workers.emplace_back(new Worker("round_robin"));
+    }
+
+    void push(Task&& task) override {
+        _workers[_next++ % _workers.size()]->push(std::move(task));
+    }
+};
+
+void expect_all_in_state(TaskGraph::Report const& report, TaskGraph::NodeState state) {
+    for (const auto& node : report.Nodes)
+        EXPECT_EQ(node.State, state) << node.Name.c_str();
+}
+}
+
+TEST(TaskGraphTest, DiamondOrder) {
+    RoundRobinExecutor executor(3);
+    TaskGraph graph("diamond");
+
+    std::atomic<int> order(0);
+    int a = -1, b = -1, c = -1, d = -1;
+    const auto node_a = graph.add_node("a", [&](ICancellationHandle&) { a = order++; });
+    const auto node_b = graph.add_node("b", [&](ICancellationHandle&) { b = order++; });
+    const auto node_c = graph.add_node("c", [&](ICancellationHandle&) { c = order++; });
+    const auto node_d = graph.add_node("d", [&](ICancellationHandle&) { d = order++; });
+    graph.add_edge(node_a, node_b);
+    graph.add_edge(node_a, node_c);
+    graph.add_edge(node_b, node_d);
+    graph.add_edge(node_c, node_d);
+
+    EXPECT_THROW(graph.add_edge(node_d, node_a), TaskGraphCycleException);
+
+    for (int i = 0; i < 100; ++i) {
+        order = 0;
+        const TaskGraph::Report report = graph.run(executor, *DummyCancellationHandle());
+
+        EXPECT_EQ(a, 0);
+        EXPECT_TRUE(b > 0 && c > 0);
+        EXPECT_EQ(d, 3);
+        EXPECT_FALSE(report.Cancelled);
+        expect_all_in_state(report, TaskGraph::NodeState::Completed);
+    }
+}
+
+TEST(TaskGraphTest, WideFanOut) {
+    RoundRobinExecutor executor(4);
+    TaskGraph graph("wide");
+
+    std::atomic<int> sum(0);
+    const auto root = graph.add_node("root", [](ICancellationHandle&) {});
+    const auto sink = graph.add_node("sink", [&](ICancellationHandle&) { EXPECT_EQ(sum.load(), 500); });
+    for (int i = 0; i < 500; ++i) {
+        const auto node = graph.add_node("node", [&](ICancellationHandle&) { ++sum; });
+        graph.add_edge(root, node);
+        graph.add_edge(node, sink);
+    }
+
+    graph.run(executor, *DummyCancellationHandle());
+    EXPECT_EQ(sum.load(), 500);
+}
+
+TEST(TaskGraphTest, FailureSkipsSuccessors) {
+    RoundRobinExecutor executor(2);
+    TaskGraph graph("failing");
+
+    std::atomic<int> ran(0);
+    const auto failing = graph.add_node("failing", [](ICancellationHandle&) { throw std::runtime_error("failed"); });
+    const auto successor = graph.add_node("successor", [&](ICancellationHandle&) { ++ran; });
+    graph.add_edge(failing, successor);
+
+    EXPECT_THROW(graph.run(executor, *DummyCancellationHandle()), std::runtime_error);
+    EXPECT_EQ(ran.load(), 0);
+}
+
+TEST(TaskGraphTest, FailureKeepsPartialReport) {
+    RoundRobinExecutor executor(2);
+    TaskGraph graph("failing");
+
+    const auto completed = graph.add_node("completed", [](ICancellationHandle&) {});
+    const auto failing = graph.add_node("failing", [](ICancellationHandle&) { throw std::runtime_error("failed"); });
+    const auto successor = graph.add_node("successor", [](ICancellationHandle&) {});
+    graph.add_edge(completed, failing);
+    graph.add_edge(failing, successor);
+
+    const auto report = graph.try_run(executor, *DummyCancellationHandle());
+    ASSERT_TRUE((bool)report.Error);
+    EXPECT_THROW(std::rethrow_exception(report.Error), std::runtime_error);
+    EXPECT_FALSE(report.Cancelled);
+
+    ASSERT_EQ(report.Nodes.size(), 3u);
+    EXPECT_EQ(report.Nodes[completed].State, TaskGraph::NodeState::Completed);
+    EXPECT_EQ(report.Nodes[failing].State, TaskGraph::NodeState::Failed);
+    EXPECT_EQ(report.Nodes[successor].State, TaskGraph::NodeState::Skipped);
+}
+
+TEST(TaskGraphTest, CancelledDuringRun) {
+    RoundRobinExecutor executor(2);
+    TaskGraph graph("cancelled");
+
+    CancellationToken token;
+    std::atomic<int> ran(0);
+    const auto canceller = graph.add_node("canceller", [&](ICancellationHandle&) { token.cancel(); });
+    const auto successor = graph.add_node("successor", [&](ICancellationHandle&) { ++ran; });
+    graph.add_edge(canceller, successor);
+
+    const TaskGraph::Report report = graph.run(executor, token);
+    EXPECT_TRUE(report.Cancelled);
+    EXPECT_EQ(report.Nodes[0].State, TaskGraph::NodeState::Completed);
+    EXPECT_EQ(report.Nodes[1].State, TaskGraph::NodeState::Skipped);
+    EXPECT_EQ(ran.load(), 0);
+}
+
+TEST(TaskGraphTest, AlreadyCancelled) {
+    RoundRobinExecutor executor(2);
+    TaskGraph graph("already_cancelled");
+
+    std::atomic<int> ran(0);
+    const auto first = graph.add_node("first", [&](ICancellationHandle&) { ++ran; });
+    const auto second = graph.add_node("second", [&](ICancellationHandle&) { ++ran; });
+    graph.add_edge(first, second);
+
+    CancellationToken token;
+    token.cancel();
+
+    const TaskGraph::Report report = graph.run(executor, token);
+    EXPECT_TRUE(report.Cancelled);
+    expect_all_in_state(report, TaskGraph::NodeState::Skipped);
+    EXPECT_EQ(ran.load(), 0);
+}
+
+TEST(TaskGraphTest, RunFromTaskOnSameWorker) {
+    std::atomic<int> ran(0);
+    Latch done(1);
+    Worker worker("graph_worker");
+
+    TaskGraph graph("nested");
+    const auto root = graph.add_node("root", [&](ICancellationHandle&) { ++ran; });
+    for (int i = 0; i < 10; ++i)
+        graph.add_edge(root, graph.add_node("leaf", [&](ICancellationHandle&) { ++ran; }));
+
+    worker.push([&] {
+        const TaskGraph::Report report = graph.run(worker, *DummyCancellationHandle());
+        EXPECT_FALSE(report.Cancelled);
+        done.count_down();
+    });
+
+    done.wait(*DummyCancellationHandle());
+    EXPECT_EQ(ran.load(), 11);
+}
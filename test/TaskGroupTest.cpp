@@ -0,0 +1,81 @@
+#include <gum/async/TaskGroup.h>
+#include <gum/concurrency/CancellationToken.h>
+#include <gum/concurrency/DummyCancellationHandle.h>
+#include <gum/concurrency/Worker.h>
+#include <gum/time/Types.h>
+
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+using namespace gum;
+
+TEST(TaskGroupTest, WaitJoinsNestedGroups) {
+    std::atomic<int> counter(0);
+    Worker worker("task_group_worker");
+
+    TaskGroup group(worker);
+    for (int i = 0; i < 50; ++i)
+        group.spawn([&](ICancellationHandle&) {
+            TaskGroup inner(worker);
+            for (int j = 0; j < 10; ++j)
+                inner.spawn([&](ICancellationHandle&) { ++counter; });
+            EXPECT_TRUE(inner.wait(*DummyCancellationHandle()));
+        });
+
+    EXPECT_TRUE(group.wait(*DummyCancellationHandle()));
+    EXPECT_EQ(counter.load(), 500);
+}
+
+TEST(TaskGroupTest, FailureCancelsSiblings) {
+    std::atomic<bool> sibling_cancelled(false);
+    Worker worker("task_group_worker");
+
+    TaskGroup group(worker);
+    group.spawn([&](ICancellationHandle& handle) {
+        handle.sleep(Seconds(5));
+        sibling_cancelled = !handle;
+    });
+    group.spawn([](ICancellationHandle&) { throw std::runtime_error("task failed"); });
+
+    EXPECT_THROW(group.wait(*DummyCancellationHandle()), std::runtime_error);
+    EXPECT_TRUE(sibling_cancelled.load());
+    EXPECT_TRUE(group.is_cancelled());
+    EXPECT_FALSE(group.wait(*DummyCancellationHandle()));
+}
+
+TEST(TaskGroupTest, CancelledWaitCancelsGroup) {
+    Worker worker("task_group_worker");
+    TaskGroup group(worker);
+    for (int i = 0; i < 2; ++i)
+        group.spawn([](ICancellationHandle& handle) { handle.sleep(Seconds(5)); });
+
+    CancellationToken waiter;
+    std::thread canceller([&] {
+        std::this_thread::sleep_for(Milliseconds(20));
+        waiter.cancel();
+    });
+
+    const auto start = SteadyClock::now();
+    EXPECT_FALSE(group.wait(waiter));
+    canceller.join();
+    EXPECT_LT(SteadyClock::now() - start, Seconds(2));
+    EXPECT_TRUE(group.is_cancelled());
+}
+
+TEST(TaskGroupTest, ParentCancellationPropagates) {
+    Worker worker("task_group_worker");
+    CancellationToken parent;
+
+    TaskGroup group(worker, parent);
+    group.spawn([](ICancellationHandle& handle) { handle.sleep(Seconds(5)); });
+    EXPECT_FALSE(group.is_cancelled());
+
+    const auto start = SteadyClock::now();
+    parent.cancel();
+    EXPECT_TRUE(group.is_cancelled());
+    EXPECT_FALSE(group.wait(*DummyCancellationHandle()));
+    EXPECT_LT(SteadyClock::now() - start, Seconds(2));
+}
@@ -0,0 +1,186 @@
+#include <gum/async/TaskQueue.h>
+#include <gum/concurrency/CancellationToken.h>
+#include <gum/concurrency/Thread.h>
+#include <gum/concurrency/Worker.h>
+
+#include <atomic>
+#include <vector>
+
+#include <poll.h>
+
+#include <gtest/gtest.h>
+
+using namespace gum;
+
+namespace {
+
+using Trace = std::vector<int>;
+
+auto record(Trace& trace, int value) {
+    return [&trace, value] { trace.push_back(value); };
+}
+
+bool is_readable(int fd) {
+    pollfd descriptor = {fd, POLLIN, 0};
+    return poll(&descriptor, 1, 0) == 1;
+}
+}
+
+TEST(TaskQueueTest, RejectPolicy) {
+    Trace trace;
+    TaskQueue queue(TaskQueueLimits(2, OverflowPolicy::Reject));
+
+    EXPECT_EQ(queue.try_push(record(trace, 1)), PushResult::Queued);
+    EXPECT_EQ(queue.try_push(record(trace, 2)), PushResult::Queued);
+    EXPECT_EQ(queue.try_push(record(trace, 3)), PushResult::Rejected);
+    EXPECT_THROW(queue.push(record(trace, 3)), TaskQueueOverflowException);
+    EXPECT_EQ(queue.size(), 2u);
+
+    queue.run();
+    EXPECT_EQ(trace, (Trace{1, 2}));
+}
+
+TEST(TaskQueueTest, DropOldestPolicy) {
+    Trace trace;
+    TaskQueue queue(TaskQueueLimits(2, OverflowPolicy::DropOldest));
+
+    queue.push(record(trace, 1));
+    queue.push(record(trace, 2));
+    EXPECT_EQ(queue.try_push(record(trace, 3)), PushResult::DisplacedOldest);
+
+    queue.run();
+    EXPECT_EQ(trace, (Trace{2, 3}));
+}
+
+TEST(TaskQueueTest, CoalescePolicy) {
+    Trace trace;
+    TaskQueue queue(TaskQueueLimits(3, OverflowPolicy::Coalesce));
+
+    EXPECT_EQ(queue.try_push(7, record(trace, 1)), PushResult::Queued);
+    EXPECT_EQ(queue.try_push(record(trace, 2)), PushResult::Queued);
+    EXPECT_EQ(queue.try_push(7, record(trace, 3)), PushResult::Coalesced);
+    EXPECT_EQ(queue.try_push(8, record(trace, 4)), PushResult::Queued);
+    EXPECT_EQ(queue.try_push(9, record(trace, 5)), PushResult::Rejected);
+    EXPECT_EQ(queue.try_push(8, record(trace, 6)), PushResult::Coalesced);
+
+    queue.run();
+    EXPECT_EQ(trace, (Trace{3, 2, 6}));
+
+    EXPECT_EQ(queue.try_push(7, record(trace, 1)), PushResult::Queued);
+    EXPECT_EQ(queue.size(), 1u);
+}
+
+TEST(TaskQueueTest, BlockPolicyWaitsForSpace) {
+    TaskQueue queue(TaskQueueLimits(1, OverflowPolicy::Block));
+    queue.push([] {});
+
+    CancellationToken token;
+    std::atomic<int> result(-1);
+    {
+        Thread producer("producer", [&](ICancellationHandle&) { result = int(queue.push([] {}, token)); });
+
+        Thread::sleep(Milliseconds(50));
+        EXPECT_EQ(result.load(), -1);
+
+        queue.run_n(1);
+        while (result.load() == -1)
+            Thread::sleep(Milliseconds(1));
+        EXPECT_EQ(result.load(), int(PushResult::Queued));
+    }
+    EXPECT_EQ(queue.size(), 1u);
+}
+
+TEST(TaskQueueTest, BlockPolicyCancelled) {
+    TaskQueue queue(TaskQueueLimits(1, OverflowPolicy::Block));
+    queue.push([] {});
+
+    CancellationToken token;
+    std::atomic<int> result(-1);
+    {
+        Thread producer("producer", [&](ICancellationHandle&) { result = int(queue.push([] {}, token)); });
+
+        Thread::sleep(Milliseconds(50));
+        token.cancel();
+    }
+    EXPECT_EQ(result.load(), int(PushResult::Cancelled));
+    EXPECT_EQ(queue.size(), 1u);
+}
+
+TEST(TaskQueueTest, BoundedWorkerRunsEverything) {
+    std::atomic<int> counter(0);
+    {
+        Worker worker("worker", TaskQueueLimits(4, OverflowPolicy::Block));
+        for (int i = 0; i < 1000; ++i)
+            worker.push([&] { ++counter; });
+
+        while (counter.load() != 1000)
+            Thread::sleep(Milliseconds(1));
+    }
+    EXPECT_EQ(counter.load(), 1000);
+}
+
+TEST(TaskQueueTest, RunN) {
+    TaskQueue queue;
+    int counter = 0;
+    for (int i = 0; i < 10; ++i)
+        queue.push([&] { ++counter; });
+
+    EXPECT_EQ(queue.run_n(3), 3u);
+    EXPECT_EQ(counter, 3);
+    EXPECT_EQ(queue.run_n(100), 7u);
+    EXPECT_EQ(counter, 10);
+    EXPECT_EQ(queue.run_n(5), 0u);
+}
+
+TEST(TaskQueueTest, RunForStopsAtBudget) {
+    TaskQueue queue;
+    int counter = 0;
+    queue.push([&] {
+        Thread::sleep(Milliseconds(30));
+        ++counter;
+    });
+    queue.push([&] { ++counter; });
+
+    EXPECT_EQ(queue.run_for(Milliseconds(10)), 1u);
+    EXPECT_EQ(counter, 1);
+    EXPECT_EQ(queue.run_for(Seconds(1)), 1u);
+    EXPECT_EQ(counter, 2);
+}
+
+TEST(TaskQueueTest, ReadinessDescriptor) {
+    TaskQueue queue;
+    const int fd = queue.get_readiness_descriptor();
+    EXPECT_FALSE(is_readable(fd));
+
+    queue.push([] {});
+    queue.push([] {});
+    EXPECT_TRUE(is_readable(fd));
+
+    queue.run_n(1);
+    EXPECT_TRUE(is_readable(fd));
+
+    queue.run();
+    EXPECT_FALSE(is_readable(fd));
+}
+
+TEST(TaskQueueTest, RunUntilCancelled) {
+    TaskQueue queue;
+    CancellationToken token;
+    std::atomic<int> counter(0);
+    std::atomic<bool> finished(false);
+
+    Thread consumer("consumer", [&](ICancellationHandle&) {
+        queue.run_until(token);
+        finished = true;
+    });
+
+    for (int i = 0; i < 100; ++i)
+        queue.push([&] { ++counter; });
+    while (counter.load() != 100)
+        Thread::sleep(Milliseconds(1));
+
+    EXPECT_FALSE(finished.load());
+    token.cancel();
+    while (!finished.load())
+        Thread::sleep(Milliseconds(1));
+}